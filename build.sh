@@ -1,18 +1,44 @@
 #!/usr/bin/env bash
+# Usage: ./build.sh [baseline|simd|all]   (default: all)
+#   baseline -> dist/battleship.js + .wasm       runs in every browser; built for size
+#   simd     -> dist/battleship-simd.js + .wasm  WASM SIMD128 + pthread worker pool;
+#               needs a cross-origin isolated page (scripts/serve_isolated.py).
+# wasmLoader.js picks the SIMD build when the browser supports it.
 set -euo pipefail
+FLAVOR="${1:-all}"
 mkdir -p dist
-emcc \
-  src/battleship.cpp \
-  src/MLforAI.cpp \
-  src/Tournament.cpp \
-  src/wasm_exports.cpp \
-  -O2 -std=c++17 \
-  -s WASM=1 \
-  -s EXPORTED_FUNCTIONS='["_startTournament","_tickTournament","_isTournamentDone","_getBoardSnapshot","_getHeatmapSnapshot","_getPlayer1BoardSnapshot","_getPlayer2BoardSnapshot","_getPlayer1HeatmapSnapshot","_getPlayer2HeatmapSnapshot","_setAIWeightsFromArray","_getAIWeightsToArray","_makePlayerMove","_isPlayerTurn","_advanceAITurn"]' \
-  -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap","HEAPF32"]' \
-  -s MODULARIZE=1 \
-  -s EXPORT_ES6=1 \
-  -s ALLOW_MEMORY_GROWTH=1 \
-  -o dist/battleship.js
 
-echo "Build complete: dist/battleship.js + dist/battleship.wasm"
+# Console-free core only: src/console.cpp and the native CLIs are never linked here
+SOURCES=(
+  src/battleship.cpp
+  src/MLforAI.cpp
+  src/Tournament.cpp
+  src/simd_kernels.cpp
+  src/Metrics.cpp
+  src/wasm_exports.cpp
+)
+EXPORTS='["_createTournament","_destroyTournament","_tickTournamentH","_tickTournamentBatchH","_isTournamentDoneH","_getSharedStatePtrH","_setAIWeightsH","_getAIWeightsH","_startTournament","_tickTournament","_tickTournamentBatch","_isTournamentDone","_getSharedStatePtr","_getSharedStateGeneration","_getBoardSnapshot","_getHeatmapSnapshot","_getPlayer1BoardSnapshot","_getPlayer2BoardSnapshot","_getPlayer1HeatmapSnapshot","_getPlayer2HeatmapSnapshot","_setAIWeightsFromArray","_getAIWeightsToArray","_makePlayerMove","_isPlayerTurn","_advanceAITurn","_setAIMoveBudget","_setLearnPrior","_getLastMoveTier","_runGamesBatch","_setEngineProfileMode","_resetEngineProfile","_getEngineProfileCounters","_getEngineProfilePhaseName","_getEngineProfileSummary","_getEngineProfileTrace","_malloc","_free"]'
+COMMON=(
+  -std=c++17
+  -s WASM=1
+  -s EXPORTED_FUNCTIONS="$EXPORTS"
+  -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap","HEAPF32","HEAPU8"]'
+  -s MODULARIZE=1
+  -s EXPORT_ES6=1
+  -s ALLOW_MEMORY_GROWTH=1
+  -s FILESYSTEM=0
+)
+
+if [[ "$FLAVOR" == "baseline" || "$FLAVOR" == "all" ]]; then
+  emcc "${SOURCES[@]}" -Os "${COMMON[@]}" -o dist/battleship.js
+  echo "Build complete: dist/battleship.js + dist/battleship.wasm"
+fi
+
+if [[ "$FLAVOR" == "simd" || "$FLAVOR" == "all" ]]; then
+  # Pool size matches WorkerPool::shared() so no thread has to be spawned lazily
+  emcc "${SOURCES[@]}" src/WorkerPool.cpp -O3 -msimd128 -pthread -DBATTLESHIP_THREADS \
+    "${COMMON[@]}" \
+    -s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency \
+    -o dist/battleship-simd.js
+  echo "Build complete: dist/battleship-simd.js + dist/battleship-simd.wasm"
+fi
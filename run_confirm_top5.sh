@@ -1,7 +1,10 @@
 #!/usr/bin/env bash
 set -euo pipefail
 OUT="tuner_confirm_top5.csv"
-echo "alphaEarly,placementHitMultiplier,adjHitBonus,mcBlendRatio,games,threads,p1_avg_shots,p2_avg_shots" > "$OUT"
+# Fixed seed + results cache: re-runs only play games not already stored
+SEED=${SEED:-1}
+CACHE=${CACHE:-.tuner_cache}
+echo "alphaEarly,placementHitMultiplier,adjHitBonus,mcBlendRatio,games,threads,p1_avg_shots,p2_avg_shots,p1_p50,p1_p90,p1_p99,p2_p50,p2_p90,p2_p99,move_us_p50,move_us_p90,move_us_p99,mc_us_p50,mc_us_p90,mc_us_p99" > "$OUT"
 
 candidates=(
 "0.800 2.000 0.200 0.500"
@@ -14,7 +17,7 @@ candidates=(
 for c in "${candidates[@]}"; do
   read alpha place adj mc <<< "$c"
   echo "Running: alpha=$alpha place=$place adj=$adj mc=$mc"
-  ./tuner games=1000 threads=8 alpha="$alpha" place="$place" adj="$adj" mc="$mc" | tail -n 1 >> "$OUT"
+  ./tuner games=1000 threads=8 seed="$SEED" cache="$CACHE" alpha="$alpha" place="$place" adj="$adj" mc="$mc" | tail -n 1 >> "$OUT"
   echo "Appended result to $OUT: $(tail -n 1 $OUT)"
 done
 
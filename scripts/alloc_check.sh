@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# Allocation check.
+#
+# Builds tuner_allocs: the engine plus src/alloc_check.cpp, linked with the
+# counting operator new in src/AllocCounter.cpp, which stays out of the shipped
+# tuner. Runs it on the plain build and on the worker-pool build
+# (-DBATTLESHIP_THREADS); either exits 1 if a steady-state CvC game allocates.
+#
+# Usage: scripts/alloc_check.sh [games=<n>] [seed=<s>] [budget=<ms>]
+set -euo pipefail
+
+OUT=${OUT:-build/allocs}
+mkdir -p "$OUT"
+
+SOURCES=(src/battleship.cpp src/MLforAI.cpp src/Tournament.cpp src/simd_kernels.cpp src/Metrics.cpp
+         src/mc_cuda_stub.cpp src/AllocCounter.cpp src/alloc_check.cpp)
+
+g++ -std=c++17 -O2 -pthread "${SOURCES[@]}" -o "$OUT/tuner_allocs"
+g++ -std=c++17 -O2 -pthread -DBATTLESHIP_THREADS "${SOURCES[@]}" src/WorkerPool.cpp -o "$OUT/tuner_allocs_mt"
+
+status=0
+echo "== plain"
+"$OUT/tuner_allocs" "$@" || status=1
+echo "== worker pool"
+"$OUT/tuner_allocs_mt" "$@" || status=1
+
+if [ "$status" -eq 0 ]; then echo "allocation check passed"; else echo "allocation check FAILED"; fi
+exit "$status"
@@ -13,6 +13,9 @@ mkdir -p build
 
 
 
+# Engine build hash keys the tuner's results cache (changes whenever the sources do)
+ENGINE_HASH=$(cat src/*.cpp src/*.h src/*.cu | sha256sum | cut -c1-16)
+
 # Compile CUDA object (mc_cuda) with -dc to ensure host symbols are linked
 nvcc -std=c++17 -O3 -Xcompiler -fPIC -dc src/mc_cuda.cu -o build/mc_cuda.o
 
@@ -20,7 +23,17 @@ nvcc -std=c++17 -O3 -Xcompiler -fPIC -dc src/mc_cuda.cu -o build/mc_cuda.o
 g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/battleship.cpp -o build/battleship.o
 g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/MLforAI.cpp -o build/MLforAI.o
 g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/Tournament.cpp -o build/Tournament.o
-g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/tuner.cpp -o build/tuner.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/BatchTournament.cpp -o build/BatchTournament.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/LayoutCorpus.cpp -o build/LayoutCorpus.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/Distill.cpp -o build/Distill.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/FeatureExport.cpp -o build/FeatureExport.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/MoveServer.cpp -o build/MoveServer.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -DENGINE_BUILD_HASH="\"$ENGINE_HASH\"" -c src/tuner.cpp -o build/tuner.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/Golden.cpp -o build/Golden.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/Replay.cpp -o build/Replay.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -DENGINE_BUILD_HASH="\"$ENGINE_HASH\"" -c src/ResultStore.cpp -o build/ResultStore.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/simd_kernels.cpp -o build/simd_kernels.o
+g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/Metrics.cpp -o build/Metrics.o
 g++ -std=c++17 -O3 -fPIC -pthread -DUSE_CUDA -c src/mc_cuda_host.cpp -o build/mc_cuda_host.o
 
 # Link all objects explicitly (including CUDA object) into a single `tuner` binary using nvcc
@@ -28,7 +41,17 @@ nvcc -std=c++17 -O3 -Xcompiler -fPIC \
 	build/battleship.o \
 	build/MLforAI.o \
 	build/Tournament.o \
+	build/BatchTournament.o \
+	build/LayoutCorpus.o \
+	build/Distill.o \
+	build/FeatureExport.o \
+	build/MoveServer.o \
 	build/tuner.o \
+	build/Golden.o \
+	build/Replay.o \
+	build/ResultStore.o \
+	build/simd_kernels.o \
+	build/Metrics.o \
 	build/mc_cuda.o \
 	build/mc_cuda_host.o \
 	-o tuner -lcudart -lcurand -lpthread
@@ -16,8 +16,11 @@ MC=${MC:-0.500}
 
 echo "Compare CPU vs GPU tuner (games=${GAMES})"
 
+# Engine build hash keys the tuner's results cache (changes whenever the sources do)
+ENGINE_HASH=$(cat src/*.cpp src/*.h src/*.cu | sha256sum | cut -c1-16)
+
 echo "Building CPU-only tuner (./tuner_cpu)..."
-g++ -std=c++17 -O3 -pthread src/battleship.cpp src/MLforAI.cpp src/Tournament.cpp src/tuner.cpp src/mc_cuda_stub.cpp -o "$CPU_BIN"
+g++ -std=c++17 -O3 -pthread -DENGINE_BUILD_HASH="\"$ENGINE_HASH\"" src/battleship.cpp src/MLforAI.cpp src/Tournament.cpp src/BatchTournament.cpp src/LayoutCorpus.cpp src/Distill.cpp src/FeatureExport.cpp src/MoveServer.cpp src/tuner.cpp src/Golden.cpp src/Replay.cpp src/ResultStore.cpp src/Metrics.cpp src/simd_kernels.cpp src/mc_cuda_stub.cpp -o "$CPU_BIN"
 
 if command -v nvcc >/dev/null 2>&1; then
   echo "nvcc found — building GPU tuner"
@@ -0,0 +1,92 @@
+#!/usr/bin/env bash
+# Golden-output determinism check.
+#
+# Records a corpus of seeded CvC games with the reference build (portable
+# kernels, -O2, no threads), then replays it on every other build: the SSE2
+# kernels at -O3, the worker-pool Monte Carlo (-DBATTLESHIP_THREADS) with pools
+# of each size in POOLS and, when emcc is on the PATH, the baseline and
+# SIMD128 + pthreads WASM builds under node. Each build checks the scalar and
+# batch engines and fails on any different shot or live map, Monte Carlo
+# blends included. A second corpus plays with the learned placement prior on
+# (prior=1), so it covers the prior's lazy decay on both engines, and one corpus
+# per rule set in VARIANTS (rules=8x8, 12x12, 15x15) plays the templated engine
+# on the other boards and fleets.
+#
+# Usage: scripts/golden_check.sh [golden-file...]
+#   With files, checks against them instead of recording fresh corpora, e.g. ones
+#   recorded at a known-good commit.
+set -euo pipefail
+
+GAMES=${GAMES:-64}
+SEED=${SEED:-1}
+BLOCK=${BLOCK:-4}
+THREADS=${THREADS:-4}
+POOLS=${POOLS:-"1 2 4"}
+VARIANTS=${VARIANTS:-"8x8 12x12 15x15"}
+OUT=${OUT:-build/golden}
+mkdir -p "$OUT"
+
+CORE=(src/battleship.cpp src/MLforAI.cpp src/Tournament.cpp src/BatchTournament.cpp src/Golden.cpp
+      src/simd_kernels.cpp src/Metrics.cpp)
+TUNER=("${CORE[@]}" src/LayoutCorpus.cpp src/Distill.cpp src/FeatureExport.cpp src/MoveServer.cpp src/tuner.cpp
+       src/Replay.cpp src/ResultStore.cpp src/mc_cuda_stub.cpp)
+
+echo "Building reference tuner (portable kernels)..."
+g++ -std=c++17 -O2 -pthread -DBATTLESHIP_SCALAR_KERNELS "${TUNER[@]}" -o "$OUT/tuner_ref"
+
+if [ $# -eq 0 ]; then
+  GOLDENS=("$OUT/golden.txt" "$OUT/golden-prior.txt")
+  "$OUT/tuner_ref" golden record out="${GOLDENS[0]}" games="$GAMES" seed="$SEED" block="$BLOCK" threads="$THREADS"
+  "$OUT/tuner_ref" golden record out="${GOLDENS[1]}" games="$GAMES" seed="$SEED" block="$BLOCK" threads="$THREADS" \
+    prior=1
+  for rules in $VARIANTS; do
+    GOLDENS+=("$OUT/golden-$rules.txt")
+    "$OUT/tuner_ref" golden record out="$OUT/golden-$rules.txt" games="$GAMES" seed="$SEED" block="$BLOCK" \
+      threads="$THREADS" rules="$rules"
+  done
+else
+  GOLDENS=("$@")
+fi
+
+g++ -std=c++17 -O3 -pthread "${TUNER[@]}" -o "$OUT/tuner_o3"
+g++ -std=c++17 -O2 -pthread -DBATTLESHIP_THREADS "${TUNER[@]}" src/WorkerPool.cpp -o "$OUT/tuner_mt"
+WASM=0
+if command -v emcc >/dev/null 2>&1 && command -v node >/dev/null 2>&1; then
+  WASM=1
+  emcc -std=c++17 -O2 "${CORE[@]}" src/golden_wasm.cpp -s NODERAWFS=1 -s ALLOW_MEMORY_GROWTH=1 \
+    -o "$OUT/golden-wasm.js"
+
+  # main() runs proxied to a pthread: on the main thread the pool would run every job inline
+  MAX_POOL=$(printf '%s\n' $POOLS | sort -n | tail -1)
+  emcc -std=c++17 -O3 -msimd128 -pthread -DBATTLESHIP_THREADS "${CORE[@]}" src/WorkerPool.cpp src/golden_wasm.cpp \
+    -s NODERAWFS=1 -s ALLOW_MEMORY_GROWTH=1 -s PROXY_TO_PTHREAD=1 -s PTHREAD_POOL_SIZE="$MAX_POOL" \
+    -o "$OUT/golden-wasm-simd.js"
+else
+  echo "emcc or node not found — WASM checks skipped"
+fi
+
+status=0
+check() {
+  local name=$1
+  shift
+  echo "== $name"
+  "$@" || status=1
+}
+
+for GOLDEN in "${GOLDENS[@]}"; do
+  echo "=== $GOLDEN"
+  check "reference" "$OUT/tuner_ref" golden check golden="$GOLDEN" threads="$THREADS"
+  check "native -O3" "$OUT/tuner_o3" golden check golden="$GOLDEN" threads="$THREADS"
+  for pool in $POOLS; do
+    check "native worker pool of $pool" "$OUT/tuner_mt" golden check golden="$GOLDEN" threads="$THREADS" pool="$pool"
+  done
+  if [ "$WASM" -eq 1 ]; then
+    check "wasm" node "$OUT/golden-wasm.js" "$GOLDEN"
+    for pool in $POOLS; do
+      check "wasm simd + pool of $pool" node "$OUT/golden-wasm-simd.js" "$GOLDEN" "$pool"
+    done
+  fi
+done
+
+if [ "$status" -eq 0 ]; then echo "golden check passed"; else echo "golden check FAILED"; fi
+exit "$status"
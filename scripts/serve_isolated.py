@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+"""Static file server that sends the COOP/COEP headers SharedArrayBuffer needs.
+
+The SIMD/threads build (dist/battleship-simd.js) only loads on a cross-origin
+isolated page; plain `python3 -m http.server` falls back to the baseline build.
+
+Usage: python3 scripts/serve_isolated.py [port]   (default 8000)
+"""
+import http.server
+import sys
+
+
+class IsolatedHandler(http.server.SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header("Cross-Origin-Opener-Policy", "same-origin")
+        self.send_header("Cross-Origin-Embedder-Policy", "require-corp")
+        super().end_headers()
+
+
+if __name__ == "__main__":
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 8000
+    http.server.ThreadingHTTPServer(("", port), IsolatedHandler).serve_forever()
@@ -0,0 +1,115 @@
+// simRing.js - SharedArrayBuffer ring between simWorker.js (writer) and the page (reader)
+//
+// The worker publishes a copy of the engine's SharedGameState block (see
+// src/Tournament.h) after each batch of ticks and appends that batch's 12-byte
+// TickEvent records. The page picks up the newest state once per frame and
+// drains the events for its log; neither side ever waits for the other.
+//
+// Layout:
+//   header       4 x Int32: latest state seq, events written, done flag,
+//                events reserved (raised before a batch's records are written)
+//   state slots  STATE_SLOTS x (Int32 seq + STATE_BYTES of SharedGameState)
+//   event ring   EVENT_SLOTS x EVENT_BYTES
+//
+// A slot's seq word is 0 while the worker rewrites it; the reader copies a slot
+// and keeps the copy only if the seq was the published one before and after.
+
+export const STATE_BYTES = 1008;      // sizeof(SharedGameState)
+export const EVENT_BYTES = 12;        // sizeof(TickEvent)
+export const STATE_SLOTS = 4;
+export const EVENT_SLOTS = 4096;
+
+const HEADER_BYTES = 16;
+const SLOT_BYTES = 4 + STATE_BYTES;
+const EVENTS_OFFSET = HEADER_BYTES + STATE_SLOTS * SLOT_BYTES;
+const H_LATEST = 0, H_EVENTS = 1, H_DONE = 2, H_RESERVED = 3;
+
+export function createRing() {
+  return new SharedArrayBuffer(EVENTS_OFFSET + EVENT_SLOTS * EVENT_BYTES);
+}
+
+export class RingWriter {
+  constructor(sab) {
+    this.header = new Int32Array(sab, 0, 4);
+    this.bytes = new Uint8Array(sab);
+    this.seq = Atomics.load(this.header, H_LATEST);
+    this.written = Atomics.load(this.header, H_EVENTS);
+  }
+
+  // src: Uint8Array view of exactly STATE_BYTES
+  publishState(src) {
+    const seq = ++this.seq;
+    const slot = seq % STATE_SLOTS;
+    const slotWord = (HEADER_BYTES + slot * SLOT_BYTES) >> 2;
+    const words = new Int32Array(this.bytes.buffer);
+    Atomics.store(words, slotWord, 0);
+    this.bytes.set(src, HEADER_BYTES + slot * SLOT_BYTES + 4);
+    Atomics.store(words, slotWord, seq);
+    Atomics.store(this.header, H_LATEST, seq);
+  }
+
+  // src: Uint8Array holding count consecutive TickEvent records
+  pushEvents(src, count) {
+    Atomics.store(this.header, H_RESERVED, this.written + count);
+    for (let i = 0; i < count; ++i) {
+      const at = EVENTS_OFFSET + ((this.written + i) % EVENT_SLOTS) * EVENT_BYTES;
+      this.bytes.set(src.subarray(i * EVENT_BYTES, (i + 1) * EVENT_BYTES), at);
+    }
+    this.written += count;
+    Atomics.store(this.header, H_EVENTS, this.written);
+  }
+
+  setDone(done) { Atomics.store(this.header, H_DONE, done ? 1 : 0); }
+}
+
+export class RingReader {
+  constructor(sab) {
+    this.header = new Int32Array(sab, 0, 4);
+    this.words = new Int32Array(sab);
+    this.bytes = new Uint8Array(sab);
+    this.lastSeq = 0;
+    this.cursor = Atomics.load(this.header, H_EVENTS);
+  }
+
+  get done() { return Atomics.load(this.header, H_DONE) === 1; }
+
+  // Copies the newest state into dst (Uint8Array of STATE_BYTES). Returns false when
+  // nothing new was published or the slot was being rewritten (retry next frame).
+  readState(dst) {
+    const seq = Atomics.load(this.header, H_LATEST);
+    if (seq === this.lastSeq) return false;
+    const slot = seq % STATE_SLOTS;
+    const slotWord = (HEADER_BYTES + slot * SLOT_BYTES) >> 2;
+    if (Atomics.load(this.words, slotWord) !== seq) return false;
+    const start = HEADER_BYTES + slot * SLOT_BYTES + 4;
+    dst.set(this.bytes.subarray(start, start + STATE_BYTES));
+    if (Atomics.load(this.words, slotWord) !== seq) return false;
+    this.lastSeq = seq;
+    return true;
+  }
+
+  // Calls fn(DataView, offset) for each unread event; returns how many were lost
+  // because the worker lapped the reader
+  drainEvents(fn) {
+    const written = Atomics.load(this.header, H_EVENTS);
+    let dropped = 0;
+    if (written - this.cursor > EVENT_SLOTS) {
+      dropped = written - this.cursor - EVENT_SLOTS;
+      this.cursor = written - EVENT_SLOTS;
+    }
+    const copy = new Uint8Array((written - this.cursor) * EVENT_BYTES);
+    for (let i = this.cursor, k = 0; i < written; ++i, ++k) {
+      const at = EVENTS_OFFSET + (i % EVENT_SLOTS) * EVENT_BYTES;
+      copy.set(this.bytes.subarray(at, at + EVENT_BYTES), k * EVENT_BYTES);
+    }
+    // Records the writer overwrote (or was overwriting) during the copy are discarded
+    const lapped = Atomics.load(this.header, H_RESERVED) - EVENT_SLOTS;
+    const dv = new DataView(copy.buffer);
+    for (let i = this.cursor, k = 0; i < written; ++i, ++k) {
+      if (i < lapped) { dropped++; continue; }
+      fn(dv, k * EVENT_BYTES);
+    }
+    this.cursor = written;
+    return dropped;
+  }
+}
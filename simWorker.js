@@ -0,0 +1,118 @@
+// simWorker.js - hosts the tournament engine off the main thread
+// Usage (from the page):
+// const worker = new Worker('simWorker.js', { type: 'module' });
+// worker.postMessage({ cmd: 'init', ring });                 // ring from simRing.createRing()
+// worker.postMessage({ cmd: 'start', mode, games, rate, weights });  // weights: 16 floats (optional)
+// worker.postMessage({ cmd: 'rate', rate }) / { cmd: 'pause' } / { cmd: 'resume' } / { cmd: 'step' }
+// The worker ticks at `rate` moves per second on its own clock and publishes the
+// board/heatmap block and tick events into the ring; it posts { type: 'ready' },
+// { type: 'done' } and { type: 'error', message }.
+
+import { loadBattleshipModule } from './wasmLoader.js';
+import { RingWriter, STATE_BYTES, EVENT_BYTES, EVENT_SLOTS } from './simRing.js';
+
+let mod = null;
+let api = null;
+let writer = null;
+let eventBuf = 0;
+let running = false;
+let rate = 60;
+let carry = 0;
+let lastTime = 0;
+let timer = 0;
+
+function publish(count) {
+  const heap = mod.HEAPU8;
+  if (count > 0) writer.pushEvents(heap.subarray(eventBuf, eventBuf + count * EVENT_BYTES), count);
+  const ptr = api.sharedPtr();
+  writer.publishState(heap.subarray(ptr, ptr + STATE_BYTES));
+}
+
+// Plays up to n ticks and publishes them; returns true once the tournament is over
+function advance(n) {
+  let left = n;
+  while (left > 0 && !api.done()) {
+    const count = api.tickBatch(Math.min(left, EVENT_SLOTS), eventBuf);
+    if (count <= 0) break;
+    publish(count);
+    left -= count;
+  }
+  if (api.done()) {
+    writer.setDone(true);
+    running = false;
+    postMessage({ type: 'done' });
+    return true;
+  }
+  return false;
+}
+
+function loop() {
+  timer = 0;
+  if (!running) return;
+  const now = performance.now();
+  const due = (now - lastTime) / 1000 * rate + carry;
+  lastTime = now;
+  // Never fall more than a second behind (e.g. after the tab was throttled)
+  const n = Math.min(Math.floor(due), Math.max(1, Math.ceil(rate)));
+  carry = Math.min(due - n, 1);
+  if (n > 0 && advance(n)) return;
+  timer = setTimeout(loop, n > 0 ? 0 : 4);
+}
+
+function schedule() {
+  if (timer) clearTimeout(timer);
+  lastTime = performance.now();
+  carry = 0;
+  timer = setTimeout(loop, 0);
+}
+
+function setWeights(weights) {
+  if (!weights || weights.length < 16) return;
+  const ptr = mod._malloc(16 * 4);
+  try {
+    new Float32Array(mod.HEAPF32.buffer, ptr, 16).set(weights.slice(0, 16));
+    api.setWeights(ptr);
+  } finally { mod._free(ptr); }
+}
+
+self.onmessage = async (ev) => {
+  const msg = ev.data;
+  if (!msg || !msg.cmd) return;
+  try {
+    if (msg.cmd === 'init') {
+      const loaded = await loadBattleshipModule({});
+      mod = loaded.mod;
+      api = {
+        start: mod.cwrap('startTournament', null, ['number','number']),
+        tickBatch: mod.cwrap('tickTournamentBatch', 'number', ['number','number']),
+        done: mod.cwrap('isTournamentDone', 'number', []),
+        sharedPtr: mod.cwrap('getSharedStatePtr', 'number', []),
+        setWeights: mod.cwrap('setAIWeightsFromArray', null, ['number']),
+      };
+      eventBuf = mod._malloc(EVENT_SLOTS * EVENT_BYTES);
+      writer = new RingWriter(msg.ring);
+      postMessage({ type: 'ready', flavor: loaded.flavor });
+    } else if (msg.cmd === 'start') {
+      setWeights(msg.weights);
+      if (typeof msg.rate === 'number') rate = msg.rate;
+      api.start(msg.mode || 3, msg.games || 1);
+      writer.setDone(false);
+      publish(0);
+      running = true;
+      schedule();
+    } else if (msg.cmd === 'rate') {
+      rate = msg.rate;
+    } else if (msg.cmd === 'weights') {
+      setWeights(msg.weights);
+    } else if (msg.cmd === 'pause') {
+      running = false;
+    } else if (msg.cmd === 'resume') {
+      if (!api.done()) { running = true; schedule(); }
+    } else if (msg.cmd === 'step') {
+      running = false;
+      advance(1);
+    }
+  } catch (err) {
+    postMessage({ type: 'error', message: String(err) });
+  }
+};
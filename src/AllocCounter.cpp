@@ -0,0 +1,47 @@
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> allocations{0};
+
+long long heapAllocations() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+static void *countedAlloc(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void *countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(align);
+    void *p = std::aligned_alloc(a, (size + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+// The array and nothrow forms forward to these in libstdc++ and libc++, but are
+// replaced as well so every form is counted and freed consistently
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void *operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
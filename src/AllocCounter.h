@@ -0,0 +1,7 @@
+#pragma once
+
+// Heap allocation counter. Linking AllocCounter.cpp replaces the global operator
+// new / delete with malloc-backed versions that count every allocation, from any
+// thread. Only the tuner_allocs check binary links it (src/alloc_check.cpp,
+// scripts/alloc_check.sh); the tuner and the game never do.
+long long heapAllocations();
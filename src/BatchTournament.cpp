@@ -0,0 +1,80 @@
+#include "BatchTournament.h"
+#include "Metrics.h"
+
+template <class RulesT>
+void BasicBatchTournament<RulesT>::startLane(int lane, int rounds, uint64_t seed, long long firstGame) {
+    BasicTournament<RulesT> &t = lanes[lane];
+    t.weights = weights;
+    t.policy[0] = policy[0];
+    t.policy[1] = policy[1];
+    t.layouts = layouts;
+    t.layoutCount = layoutCount;
+    t.learnPrior = learnPrior;
+    t.moveBudgetMs = -1.0;
+    t.current.logMoves = false;
+    t.current.liveMaps = false;
+    t.start(3, rounds, seed, firstGame);
+    busy[lane] = true;
+}
+
+template <class RulesT>
+int BasicBatchTournament<RulesT>::step(TickEvent events[BATCH_LANES]) {
+    AIWeightsScope useWeights(weights);
+    BasicMoveLane<RulesT> in[BATCH_LANES];
+    char boards[BATCH_LANES][RulesT::ROWS][RulesT::COLS];
+    int laneOf[BATCH_LANES];
+    int n = 0, fired = 0;
+    for (int l = 0; l < BATCH_LANES; ++l) {
+        events[l] = TickEvent{};
+        events[l].flags = TICK_SKIPPED;
+        events[l].ship = -1;
+        if (!busy[l]) continue;
+        BasicRoundState<RulesT> &rs = lanes[l].current;
+        int shooter = rs.turn;
+        if (rs.policy[shooter]) {
+            lanes[l].step(&events[l]);
+            if (events[l].flags & TICK_TOURNAMENT_END) busy[l] = false;
+            fired++;
+            continue;
+        }
+        rs.aiBoard(shooter, boards[n]);
+        in[n].board = boards[n];
+        in[n].globalProb = rs.hitProb;
+        in[n].liveProb = shooter == 0 ? rs.liveProbP1 : rs.liveProbP2;
+        in[n].ts = shooter == 0 ? &rs.p1Target : &rs.p2Target;
+        in[n].remaining = shooter == 0 ? rs.computerShipSizes : rs.playerShipSizes;
+        in[n].turn = rs.turnCount;
+        in[n].hits = &rs.liveHits[shooter];
+        in[n].misses = &rs.liveMisses[shooter];
+        in[n].sunk = &rs.sunkShips[shooter].cells;
+        laneOf[n++] = l;
+    }
+    if (n == 0) return fired;
+
+    uint64_t t0 = metricsNowNs();
+    std::pair<int,int> moves[BATCH_LANES];
+    chooseAIMovesLanes(in, n, moves);
+    // Moves are chosen together; each counts as an equal share of the batch
+    if (EngineMetrics *metrics = engineMetrics()) {
+        uint64_t share = (metricsNowNs() - t0) / n;
+        for (int k = 0; k < n; ++k) metrics->moveLatencyNs.record(share);
+    }
+
+    for (int k = 0; k < n; ++k) {
+        int l = laneOf[k];
+        lanes[l].current.fire(moves[k].first, moves[k].second);
+        lanes[l].afterTick(&events[l]);
+        if (events[l].flags & TICK_TOURNAMENT_END) busy[l] = false;
+    }
+    return fired + n;
+}
+
+template <class RulesT>
+int BasicBatchTournament<RulesT>::busyLanes() const {
+    int n = 0;
+    for (int l = 0; l < BATCH_LANES; ++l) n += busy[l] ? 1 : 0;
+    return n;
+}
+
+#define INSTANTIATE_BATCH(RulesT) template struct BasicBatchTournament<RulesT>;
+FOR_EACH_GAME_RULES(INSTANTIATE_BATCH)
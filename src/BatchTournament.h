@@ -0,0 +1,36 @@
+#pragma once
+#include "Tournament.h"
+
+// Up to BATCH_LANES CvC tournaments played in lockstep, one per lane. Each step
+// every busy lane fires one shot: the moves of all lanes are chosen together by
+// chooseAIMovesLanes and applied through RoundState::fire, and lanes whose
+// tournament is over sit idle until they are given another one. A lane plays the
+// same moves (and so the same shots per game) as a Tournament started with the
+// same seed and first game. It skips the renderer-only live maps, so it has no
+// heatmaps to show and takes no move budget.
+const int BATCH_LANES = MOVE_LANES;
+
+template <class RulesT>
+struct BasicBatchTournament {
+    BasicTournament<RulesT> lanes[BATCH_LANES];
+    bool busy[BATCH_LANES] = {false};
+
+    // Optional weights used by every lane instead of the global ones
+    const AIWeights *weights = nullptr;
+    // Optional distilled policy per player for every lane (see Tournament::policy);
+    // policy moves are chosen lane by lane
+    const PolicyModel *policy[2] = {nullptr, nullptr};
+    // Optional pregenerated layouts for every lane (see Tournament::layouts)
+    const BasicFleetLayout<RulesT> *layouts = nullptr;
+    long long layoutCount = 0;
+    // Every lane learns a placement prior across its block (see Tournament::learnPrior)
+    bool learnPrior = false;
+
+    // Lane plays `rounds` games starting at game firstGame of the sweep seeded by `seed`
+    void startLane(int lane, int rounds, uint64_t seed, long long firstGame);
+    // One shot in every busy lane. events[l] receives lane l's TickEvent (TICK_SKIPPED
+    // for idle lanes); a lane goes idle on TICK_TOURNAMENT_END. Returns the lanes that fired.
+    int step(TickEvent events[BATCH_LANES]);
+    int busyLanes() const;
+};
+typedef BasicBatchTournament<StandardRules> BatchTournament;
@@ -0,0 +1,212 @@
+#include "Distill.h"
+#include "Metrics.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+static const char MODEL_MAGIC[4] = {'B', 'S', 'P', 'M'};
+static const uint32_t MODEL_VERSION = 2;
+
+struct ModelHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t features;
+    uint32_t hidden;
+    PolicyScaling scaling;      // feature divisors the model was trained with
+};
+
+static void playBlock(long long first, int n, uint64_t seed, std::vector<PolicySample> &out) {
+    Tournament t;
+    t.current.logMoves = false;
+    t.current.liveMaps = false;
+    t.start(3, n, seed, first);
+    while (!t.done()) {
+        RoundState &rs = t.current;
+        int shooter = rs.turn;
+        const char (*target)[NUM_COLS] = shooter == 0 ? rs.computerBoard : rs.playerBoard;
+        const int *sizes = shooter == 0 ? rs.computerShipSizes : rs.playerShipSizes;
+        PolicySample s;
+        char board[NUM_ROWS][NUM_COLS];
+        rs.aiBoard(shooter, board);
+        for (int r = 0; r < NUM_ROWS; ++r)
+            for (int c = 0; c < NUM_COLS; ++c) {
+                char ch = board[r][c];
+                s.view[r][c] = (ch == HIT || ch == MISS || ch == SUNK) ? ch : '-';
+                if (isShipSymbol(target[r][c]) || target[r][c] == HIT) s.ships.set(r * NUM_COLS + c);
+            }
+        s.afloat = 0;
+        for (int i = 0; i < NUM_SHIPS; ++i)
+            if (sizes[i] > 0) s.afloat |= static_cast<uint8_t>(1u << i);
+        out.push_back(s);
+        t.step(nullptr);
+    }
+}
+
+void collectPolicySamples(long long games, uint64_t seed, int blockGames, int threads,
+                          std::vector<PolicySample> &out) {
+    if (blockGames < 1) blockGames = 1;
+    if (threads < 1) threads = 1;
+    long long blocks = (games + blockGames - 1) / blockGames;
+    std::vector<std::vector<PolicySample>> perBlock(blocks);
+    std::atomic<long long> next{0};
+    std::vector<std::thread> ths;
+    for (int k = 0; k < threads; ++k)
+        ths.emplace_back([&] {
+            for (long long b; (b = next++) < blocks; ) {
+                long long first = b * blockGames;
+                playBlock(first, static_cast<int>(std::min<long long>(blockGames, games - first)), seed, perBlock[b]);
+            }
+        });
+    for (auto &th : ths) th.join();
+    // Block order, so the sample set does not depend on threads
+    for (auto &v : perBlock) out.insert(out.end(), v.begin(), v.end());
+}
+
+static void remainingOf(const PolicySample &s, int remaining[NUM_SHIPS]) {
+    for (int i = 0; i < NUM_SHIPS; ++i) remaining[i] = (s.afloat >> i) & 1 ? SHIP_SIZES[i] : 0;
+}
+
+// One pass over the samples in `order`; updates `m` by SGD when lr > 0
+static PolicyTrainStats runEpoch(const std::vector<PolicySample> &samples, const std::vector<size_t> &order,
+                                 float lr, PolicyModel &m) {
+    PolicyTrainStats st;
+    long long rows = 0, topHits = 0;
+    float x[POLICY_FEATURES][NUM_ROWS * NUM_COLS];
+    for (size_t idx : order) {
+        const PolicySample &s = samples[idx];
+        int remaining[NUM_SHIPS];
+        remainingOf(s, remaining);
+        policyFeatures(s.view, remaining, x);
+        float best = 0.0f;
+        int bestCell = -1;
+        for (int cell = 0; cell < NUM_ROWS * NUM_COLS; ++cell) {
+            if (s.view[cell / NUM_COLS][cell % NUM_COLS] != '-') continue;
+            float in[POLICY_FEATURES];
+            for (int f = 0; f < POLICY_FEATURES; ++f) in[f] = x[f][cell];
+            float a[POLICY_HIDDEN];
+            float y = m.b2;
+            for (int j = 0; j < POLICY_HIDDEN; ++j) {
+                a[j] = m.b1[j];
+                for (int f = 0; f < POLICY_FEATURES; ++f) a[j] += m.w1[j][f] * in[f];
+                if (a[j] > 0.0f) y += m.w2[j] * a[j];
+            }
+            if (bestCell < 0 || y > best) { best = y; bestCell = cell; }
+            float label = s.ships.test(cell) ? 1.0f : 0.0f;
+            float p = 1.0f / (1.0f + std::exp(-y));
+            st.logLoss -= label > 0.0f ? std::log(std::max(p, 1e-7f)) : std::log(std::max(1.0f - p, 1e-7f));
+            rows++;
+            if (lr <= 0.0f) continue;
+            // Backpropagate the logistic loss gradient (p - label)
+            float g = lr * (p - label);
+            m.b2 -= g;
+            for (int j = 0; j < POLICY_HIDDEN; ++j) {
+                if (a[j] <= 0.0f) continue;
+                float gh = g * m.w2[j];
+                m.w2[j] -= g * a[j];
+                m.b1[j] -= gh;
+                for (int f = 0; f < POLICY_FEATURES; ++f) m.w1[j][f] -= gh * in[f];
+            }
+        }
+        if (bestCell >= 0 && s.ships.test(bestCell)) topHits++;
+    }
+    if (rows > 0) st.logLoss /= rows;
+    if (!order.empty()) st.topHitRate = static_cast<double>(topHits) / order.size();
+    return st;
+}
+
+void trainPolicyModel(const std::vector<PolicySample> &samples, int epochs, float learningRate,
+                      uint64_t seed, PolicyModel &m,
+                      void (*progress)(int epoch, const PolicyTrainStats &stats)) {
+    GameRng rng;
+    rng.seed(seed);
+    // He-style uniform initialization; the output bias starts at the base rate of
+    // ship cells among unknown ones (about one in five)
+    const float s1 = std::sqrt(6.0f / POLICY_FEATURES), s2 = std::sqrt(6.0f / POLICY_HIDDEN);
+    for (int j = 0; j < POLICY_HIDDEN; ++j) {
+        for (int f = 0; f < POLICY_FEATURES; ++f) m.w1[j][f] = static_cast<float>((2.0 * rng.unit() - 1.0) * s1);
+        m.b1[j] = 0.0f;
+        m.w2[j] = static_cast<float>((2.0 * rng.unit() - 1.0) * s2);
+    }
+    m.b2 = -1.4f;
+
+    std::vector<size_t> order(samples.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (int e = 0; e < epochs; ++e) {
+        for (size_t i = order.size(); i > 1; --i) std::swap(order[i - 1], order[rng.next() % i]);
+        PolicyTrainStats st = runEpoch(samples, order, learningRate / (1.0f + e), m);
+        if (progress) progress(e + 1, st);
+    }
+}
+
+PolicyTrainStats evaluatePolicyModel(const std::vector<PolicySample> &samples, const PolicyModel &m) {
+    std::vector<size_t> order(samples.size());
+    std::iota(order.begin(), order.end(), 0);
+    PolicyModel copy = m;
+    return runEpoch(samples, order, 0.0f, copy);
+}
+
+SoloResult measureShotsToWin(const PolicyModel *policy, long long games, uint64_t seed, int blockGames,
+                             int threads) {
+    if (blockGames < 1) blockGames = 1;
+    if (threads < 1) threads = 1;
+    long long blocks = (games + blockGames - 1) / blockGames;
+    std::atomic<long long> next{0}, shots{0};
+    EngineMetrics metrics;
+    EngineMetrics *previous = engineMetrics();
+    setEngineMetrics(&metrics);
+    std::vector<std::thread> ths;
+    for (int k = 0; k < threads; ++k)
+        ths.emplace_back([&] {
+            for (long long b; (b = next++) < blocks; ) {
+                long long first = b * blockGames;
+                Tournament t;
+                t.current.logMoves = false;
+                t.current.liveMaps = false;
+                t.policy[0] = policy;
+                t.start(3, static_cast<int>(std::min<long long>(blockGames, games - first)), seed, first);
+                while (!t.done()) {
+                    RoundState &rs = t.current;
+                    rs.turn = 0;
+                    rs.tick();
+                    if (!rs.gameOver) rs.turnCount++;
+                    TickEvent ev;
+                    t.afterTick(&ev);
+                    if (ev.flags & TICK_ROUND_END) shots += ev.shotsP1;
+                }
+            }
+        });
+    for (auto &th : ths) th.join();
+    setEngineMetrics(previous);
+    SoloResult r;
+    r.avgShots = static_cast<double>(shots) / games;
+    r.moveUs = metrics.moveLatencyNs.snapshot().percentile(50) / 1000.0;
+    return r;
+}
+
+bool savePolicyModel(const std::string &path, const PolicyModel &m) {
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    ModelHeader h;
+    std::memcpy(h.magic, MODEL_MAGIC, 4);
+    h.version = MODEL_VERSION;
+    h.features = POLICY_FEATURES;
+    h.hidden = POLICY_HIDDEN;
+    h.scaling = policyScaling();
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 && std::fwrite(&m, sizeof(m), 1, f) == 1;
+    return std::fclose(f) == 0 && ok;
+}
+
+bool loadPolicyModel(const std::string &path, PolicyModel &m) {
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    ModelHeader h;
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1 && std::memcmp(h.magic, MODEL_MAGIC, 4) == 0 &&
+              h.version == MODEL_VERSION && h.features == POLICY_FEATURES && h.hidden == POLICY_HIDDEN &&
+              std::memcmp(&h.scaling, &policyScaling(), sizeof(PolicyScaling)) == 0 &&
+              std::fread(&m, sizeof(m), 1, f) == 1;
+    std::fclose(f);
+    return ok;
+}
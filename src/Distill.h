@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Tournament.h"
+
+// Offline training of the distilled policy (PolicyModel in MLforAI.h).
+//
+// Positions come from CvC games the full pipeline plays, seeded like sweep games.
+// Each records the shooter's view and the target's hidden ship cells, and every
+// unknown cell of it is one training row: the policy features and whether the
+// cell holds a ship. The model is fit by SGD on the logistic loss, so its output
+// estimates the probability of a ship given the features, which is what the
+// placement and Monte Carlo maps approximate at play time.
+
+struct PolicySample {
+    char view[NUM_ROWS][NUM_COLS];     // '-' unknown, 'X' hit, 'm' miss, SUNK resolved
+    Bitboard ships;                     // cells of the target's fleet
+    uint8_t afloat;                     // bit i: ship i not yet sunk
+};
+
+// Plays `games` games (blocks of blockGames, spread over `threads`) and appends
+// every position to `out`
+void collectPolicySamples(long long games, uint64_t seed, int blockGames, int threads,
+                          std::vector<PolicySample> &out);
+
+struct PolicyTrainStats {
+    double logLoss = 0.0;       // mean over the epoch's rows
+    double topHitRate = 0.0;    // share of positions whose top-scoring cell holds a ship
+};
+
+// Fits `m` (initialized from `seed`) to the samples. `progress`, when given, is
+// called after every epoch.
+void trainPolicyModel(const std::vector<PolicySample> &samples, int epochs, float learningRate,
+                      uint64_t seed, PolicyModel &m,
+                      void (*progress)(int epoch, const PolicyTrainStats &stats) = nullptr);
+
+// Top-cell hit rate of `m` on `samples` (no training)
+PolicyTrainStats evaluatePolicyModel(const std::vector<PolicySample> &samples, const PolicyModel &m);
+
+struct SoloResult {
+    double avgShots = 0.0;      // shots to sink the whole fleet
+    double moveUs = 0.0;        // median move choice time
+};
+
+// Shots-to-win of player 1 playing alone: `policy` when given, else the pipeline.
+// Games are seeded and blocked like a sweep (same boards for both); the opponent's
+// turns are skipped but still counted, so the pipeline's turn-based weights see
+// the clock of a two-player game.
+SoloResult measureShotsToWin(const PolicyModel *policy, long long games, uint64_t seed, int blockGames,
+                             int threads);
+
+// Model files: magic, version, layer sizes, feature scaling, then the PolicyModel
+// floats. Loading fails unless the scaling matches policyScaling().
+bool savePolicyModel(const std::string &path, const PolicyModel &m);
+bool loadPolicyModel(const std::string &path, PolicyModel &m);
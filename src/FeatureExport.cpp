@@ -0,0 +1,177 @@
+#include "FeatureExport.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static const char FEATURE_MAGIC[4] = {'B', 'S', 'F', 'X'};
+static const uint32_t FEATURE_VERSION = 1;
+static const uint32_t FEATURE_CHUNK_ROWS = 65536;
+
+const char *const FEATURE_COLUMN_NAMES[FEATURE_COLUMNS] = {
+    "game", "move", "player", "cell",
+    "global", "live", "decay", "parity",
+    "adj_hits", "adj_lines", "diag_hits", "can_fit", "fit_bias",
+    "placement", "monte_carlo", "score",
+    "chosen", "ship",
+};
+
+// One worker's output file: rows are buffered column by column and written a chunk at a time
+struct FeatureWriter {
+    FILE *f = nullptr;
+    std::vector<float> columns[FEATURE_COLUMNS];
+    uint32_t rows = 0;
+    bool ok = true;
+
+    bool open(const std::string &path, uint64_t seed, int mcIterations) {
+        f = std::fopen(path.c_str(), "wb");
+        if (!f) return ok = false;
+        FeatureFileHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, FEATURE_MAGIC, 4);
+        h.version = FEATURE_VERSION;
+        h.columns = FEATURE_COLUMNS;
+        h.chunkRows = FEATURE_CHUNK_ROWS;
+        h.seed = seed;
+        h.mcIterations = static_cast<uint32_t>(mcIterations);
+        for (int k = 0; k < FEATURE_COLUMNS; ++k)
+            std::strncpy(h.names[k], FEATURE_COLUMN_NAMES[k], sizeof(h.names[k]) - 1);
+        for (auto &col : columns) col.resize(FEATURE_CHUNK_ROWS);
+        return ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    }
+    void put(const float values[FEATURE_COLUMNS]) {
+        if (rows == FEATURE_CHUNK_ROWS) flush();
+        for (int k = 0; k < FEATURE_COLUMNS; ++k) columns[k][rows] = values[k];
+        rows++;
+    }
+    void flush() {
+        if (rows == 0 || !f) return;
+        uint32_t head[2] = {rows, 0};
+        ok = ok && std::fwrite(head, sizeof(head), 1, f) == 1;
+        for (int k = 0; k < FEATURE_COLUMNS && ok; ++k)
+            ok = std::fwrite(columns[k].data(), sizeof(float), rows, f) == rows;
+        rows = 0;
+    }
+    bool close() {
+        flush();
+        if (f && std::fclose(f) != 0) ok = false;
+        f = nullptr;
+        return ok;
+    }
+};
+
+// Fills one row per cell the side to move in `rs` could fire at, except FX_CHOSEN
+// (known once the move is played); returns how many
+static int moveRows(const RoundState &rs, long long game, uint64_t mcSeed, int mcIterations,
+                    float rows[NUM_ROWS * NUM_COLS][FEATURE_COLUMNS]) {
+    AIWeightsScope useWeights(rs.weights);
+    const int shooter = rs.turn;
+    const char (*target)[NUM_COLS] = shooter == 0 ? rs.computerBoard : rs.playerBoard;
+    const int *remaining = shooter == 0 ? rs.computerShipSizes : rs.playerShipSizes;
+    char board[NUM_ROWS][NUM_COLS];
+    rs.aiBoard(shooter, board);
+
+    // The live map chooseAIMove builds from the same board
+    double globalProb[NUM_ROWS][NUM_COLS], liveProb[NUM_ROWS][NUM_COLS];
+    std::memcpy(globalProb, rs.hitProb, sizeof(globalProb));
+    updateLiveHeatmap(board, liveProb, remaining);
+
+    char view[NUM_ROWS][NUM_COLS];
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c)
+            view[r][c] = (board[r][c] == HIT || board[r][c] == MISS || board[r][c] == SUNK) ? board[r][c] : '-';
+    double placement[NUM_ROWS][NUM_COLS], mc[NUM_ROWS][NUM_COLS] = {{0}};
+    computePlacementProbabilities(view, remaining, placement);
+    if (mcIterations > 0) {
+        // Own generator, so sampling leaves the game's random stream untouched
+        GameRng rng;
+        rng.seed(mcSeed);
+        GameRngScope useRng(rng);
+        monteCarloProbabilities(view, remaining, mcIterations, mc);
+    }
+
+    const int move = rs.shotCount[0] + rs.shotCount[1];
+    int n = 0;
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c) {
+            ScoreTerms t;
+            if (!scoreCellTerms(r, c, board, globalProb, liveProb, remaining, rs.turnCount, t)) continue;
+            float *v = rows[n++];
+            v[FX_GAME] = static_cast<float>(game);
+            v[FX_MOVE] = static_cast<float>(move);
+            v[FX_PLAYER] = static_cast<float>(shooter);
+            v[FX_CELL] = static_cast<float>(r * NUM_COLS + c);
+            v[FX_GLOBAL] = static_cast<float>(t.global);
+            v[FX_LIVE] = static_cast<float>(t.live);
+            v[FX_DECAY] = static_cast<float>(t.decay);
+            v[FX_PARITY] = static_cast<float>(t.parity);
+            v[FX_ADJ_HITS] = static_cast<float>(t.adjHits);
+            v[FX_ADJ_LINES] = static_cast<float>(t.adjLines);
+            v[FX_DIAG_HITS] = static_cast<float>(t.diagHits);
+            v[FX_CAN_FIT] = t.canFit ? 1.0f : 0.0f;
+            v[FX_FIT_BIAS] = static_cast<float>(t.fitBias);
+            v[FX_PLACEMENT] = static_cast<float>(placement[r][c]);
+            v[FX_MONTE_CARLO] = static_cast<float>(mc[r][c]);
+            v[FX_SCORE] = static_cast<float>(t.score);
+            v[FX_CHOSEN] = 0.0f;
+            v[FX_SHIP] = isShipSymbol(target[r][c]) ? 1.0f : 0.0f;
+        }
+    return n;
+}
+
+static void exportBlock(long long first, int n, const FeatureExportConfig &cfg, FeatureWriter &out,
+                        FeatureExportResult &totals) {
+    Tournament t;
+    t.current.logMoves = false;
+    t.current.liveMaps = false;
+    t.layouts = cfg.layouts;
+    t.layoutCount = cfg.layoutCount;
+    t.start(3, n, cfg.seed, first);
+    float rows[NUM_ROWS * NUM_COLS][FEATURE_COLUMNS];
+    while (!t.done()) {
+        const RoundState &rs = t.current;
+        long long game = t.firstGame + t.currentRoundIdx;
+        int move = rs.shotCount[0] + rs.shotCount[1];
+        int count = moveRows(rs, game, gameSeed(gameSeed(~cfg.seed, game), move), cfg.mcIterations, rows);
+        TickEvent ev;
+        t.step(&ev);
+        for (int k = 0; k < count; ++k) {
+            if (!(ev.flags & TICK_SKIPPED) && rows[k][FX_CELL] == ev.cell) rows[k][FX_CHOSEN] = 1.0f;
+            out.put(rows[k]);
+        }
+        totals.rows += count;
+        totals.moves++;
+    }
+}
+
+FeatureExportResult exportFeatures(const std::string &prefix, const FeatureExportConfig &cfg) {
+    const int blockGames = cfg.blockGames < 1 ? 1 : cfg.blockGames;
+    const int threads = cfg.threads < 1 ? 1 : cfg.threads;
+    const long long blocks = (cfg.games + blockGames - 1) / blockGames;
+    std::vector<FeatureWriter> writers(threads);
+    std::vector<FeatureExportResult> totals(threads);
+    std::atomic<long long> next{0};
+    std::vector<std::thread> ths;
+    for (int k = 0; k < threads; ++k)
+        ths.emplace_back([&, k] {
+            FeatureWriter &out = writers[k];
+            if (!out.open(prefix + "." + std::to_string(k) + ".bsfx", cfg.seed, cfg.mcIterations)) return;
+            for (long long b; out.ok && (b = next++) < blocks; ) {
+                long long first = b * blockGames;
+                exportBlock(first, static_cast<int>(std::min<long long>(blockGames, cfg.games - first)), cfg, out,
+                            totals[k]);
+            }
+            out.close();
+        });
+    for (auto &th : ths) th.join();
+
+    FeatureExportResult r;
+    r.ok = true;
+    for (int k = 0; k < threads; ++k) {
+        r.rows += totals[k].rows;
+        r.moves += totals[k].moves;
+        r.ok = r.ok && writers[k].ok;
+    }
+    return r;
+}
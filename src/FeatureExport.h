@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Tournament.h"
+
+// Per-move dataset of the scoring pipeline's cell terms, for offline fitting.
+//
+// Headless CvC games are played exactly as in a sweep. Before every move, each
+// cell the shooter could fire at becomes one row: the ScoreTerms scoreCell
+// combines (with the live map it is about to see), the exact placement
+// probability, a Monte Carlo estimate, which cell was fired at, and whether the
+// cell holds a ship on the hidden board.
+//
+// Files are columnar float32. After the header come chunks of up to `chunkRows`
+// rows; each chunk is a uint32 row count (plus 4 bytes of padding) followed by
+// every column's values for those rows, column by column, in FeatureColumn order.
+// Game ids are exact in float32 up to 2^24.
+
+enum FeatureColumn {
+    FX_GAME, FX_MOVE, FX_PLAYER, FX_CELL,
+    FX_GLOBAL, FX_LIVE, FX_DECAY, FX_PARITY,
+    FX_ADJ_HITS, FX_ADJ_LINES, FX_DIAG_HITS, FX_CAN_FIT, FX_FIT_BIAS,
+    FX_PLACEMENT, FX_MONTE_CARLO, FX_SCORE,
+    FX_CHOSEN, FX_SHIP,
+    FEATURE_COLUMNS
+};
+// Column names as stored in file headers
+extern const char *const FEATURE_COLUMN_NAMES[FEATURE_COLUMNS];
+
+struct FeatureFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t columns;
+    uint32_t chunkRows;
+    uint64_t seed;
+    uint32_t mcIterations;      // 0: the FX_MONTE_CARLO column is all zero
+    uint32_t pad;
+    char names[FEATURE_COLUMNS][16];
+};
+
+struct FeatureExportConfig {
+    long long games = 0;
+    uint64_t seed = 0;
+    int blockGames = 100;
+    int threads = 1;
+    int mcIterations = 0;       // Monte Carlo samples per move
+    const FleetLayout *layouts = nullptr;
+    long long layoutCount = 0;
+};
+
+struct FeatureExportResult {
+    long long rows = 0;
+    long long moves = 0;
+    bool ok = false;
+};
+
+// Plays cfg.games games over cfg.threads workers; worker k writes
+// <prefix>.<k>.bsfx. Games are blocked and seeded like sweep games, so the rows
+// of a game do not depend on the thread count (only which file they land in).
+FeatureExportResult exportFeatures(const std::string &prefix, const FeatureExportConfig &cfg);
@@ -0,0 +1,265 @@
+#include "Golden.h"
+#include "BatchTournament.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+static const uint64_t FNV_OFFSET = 1469598103934665603ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+long long goldenBlocks(const GoldenCorpus &spec) {
+    return spec.blockGames > 0 ? (spec.games + spec.blockGames - 1) / spec.blockGames : 0;
+}
+
+static int blockSize(const GoldenCorpus &spec, long long block) {
+    long long first = block * spec.blockGames;
+    return static_cast<int>(spec.games - first < spec.blockGames ? spec.games - first : spec.blockGames);
+}
+
+// The game a shot belongs to: the last one in out unless the shot starts a new game
+static GoldenGame &gameFor(std::vector<GoldenGame> &out, long long game) {
+    if (out.empty() || out.back().game != game) {
+        out.emplace_back();
+        out.back().game = game;
+        out.back().mapDigest = FNV_OFFSET;
+    }
+    return out.back();
+}
+
+static void recordShot(GoldenGame &g, const TickEvent &ev) {
+    g.shots.push_back((ev.flags & TICK_SKIPPED) ? GOLDEN_SKIPPED : ev.cell);
+}
+
+// The shooter's live map after a shot that did not end the round, as
+// RoundState::refreshLiveMaps left it
+template <class RulesT>
+static void recordMap(GoldenGame &g, const BasicRoundState<RulesT> &rs, int shooter) {
+    const double (*map)[RulesT::COLS] = shooter == 0 ? rs.liveProbP1 : rs.liveProbP2;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            float v = static_cast<float>(map[r][c]);
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            for (int k = 0; k < 4; ++k) g.mapDigest = (g.mapDigest ^ ((bits >> (8 * k)) & 0xff)) * FNV_PRIME;
+        }
+}
+
+// The weights a corpus is played with: the defaults with its sample count
+static AIWeights goldenWeights(const GoldenCorpus &spec) {
+    AIWeights w;
+    w.mcIterations = spec.mcIterations;
+    return w;
+}
+
+template <class RulesT>
+static void playScalar(const GoldenCorpus &spec, long long block, std::vector<GoldenGame> &out) {
+    const AIWeights w = goldenWeights(spec);
+    std::unique_ptr<BasicTournament<RulesT>> t(new BasicTournament<RulesT>);
+    t->weights = &w;
+    t->learnPrior = spec.learnPrior;
+    t->current.logMoves = false;
+    t->start(3, blockSize(spec, block), spec.seed, block * spec.blockGames);
+    while (!t->done()) {
+        long long game = t->firstGame + t->currentRoundIdx;
+        TickEvent ev;
+        t->step(&ev);
+        GoldenGame &g = gameFor(out, game);
+        recordShot(g, ev);
+        if (!(ev.flags & (TICK_SKIPPED | TICK_ROUND_END))) recordMap(g, t->current, ev.player);
+    }
+}
+
+template <class RulesT>
+static void playBatch(const GoldenCorpus &spec, long long firstBlock, int count, std::vector<GoldenGame> &out) {
+    const AIWeights w = goldenWeights(spec);
+    std::unique_ptr<BasicBatchTournament<RulesT>> bt(new BasicBatchTournament<RulesT>);
+    bt->weights = &w;
+    bt->learnPrior = spec.learnPrior;
+    for (long long b = firstBlock; b < firstBlock + count; b += BATCH_LANES) {
+        int lanes = static_cast<int>(firstBlock + count - b < BATCH_LANES ? firstBlock + count - b : BATCH_LANES);
+        std::vector<GoldenGame> laneGames[BATCH_LANES];
+        for (int l = 0; l < lanes; ++l)
+            bt->startLane(l, blockSize(spec, b + l), spec.seed, (b + l) * spec.blockGames);
+        TickEvent events[BATCH_LANES];
+        while (bt->busyLanes() > 0) {
+            long long game[BATCH_LANES];
+            for (int l = 0; l < BATCH_LANES; ++l)
+                game[l] = bt->busy[l] ? bt->lanes[l].firstGame + bt->lanes[l].currentRoundIdx : -1;
+            bt->step(events);
+            for (int l = 0; l < BATCH_LANES; ++l)
+                if (game[l] >= 0) recordShot(gameFor(laneGames[l], game[l]), events[l]);
+        }
+        // Lane l played block b + l, so lane order is game order
+        for (int l = 0; l < lanes; ++l)
+            for (GoldenGame &g : laneGames[l]) out.push_back(std::move(g));
+    }
+}
+
+template <class RulesT>
+static void playBlocks(const GoldenCorpus &spec, long long firstBlock, int count, GoldenBackend backend,
+                       std::vector<GoldenGame> &out) {
+    static_assert(RulesT::CELLS <= GOLDEN_SKIPPED, "shots are recorded as bytes below GOLDEN_SKIPPED");
+    if (backend == GOLDEN_BATCH) {
+        playBatch<RulesT>(spec, firstBlock, count, out);
+        return;
+    }
+    for (long long b = firstBlock; b < firstBlock + count; ++b) playScalar<RulesT>(spec, b, out);
+}
+
+const std::vector<std::string> &goldenRuleSets() {
+    static const std::vector<std::string> names = {"10x10", "8x8", "12x12", "15x15"};
+    return names;
+}
+
+bool isGoldenRuleSet(const std::string &rules) {
+    for (const std::string &name : goldenRuleSets())
+        if (name == rules) return true;
+    return false;
+}
+
+// Columns of the corpus's board, for naming cells
+static int goldenCols(const GoldenCorpus &spec) {
+    if (spec.rules == "8x8") return Rules8x8::COLS;
+    if (spec.rules == "12x12") return Rules12x12::COLS;
+    if (spec.rules == "15x15") return Rules15x15::COLS;
+    return StandardRules::COLS;
+}
+
+void playGoldenBlocks(const GoldenCorpus &spec, long long firstBlock, int count, GoldenBackend backend,
+                      std::vector<GoldenGame> &out) {
+    if (spec.rules == "8x8") playBlocks<Rules8x8>(spec, firstBlock, count, backend, out);
+    else if (spec.rules == "12x12") playBlocks<Rules12x12>(spec, firstBlock, count, backend, out);
+    else if (spec.rules == "15x15") playBlocks<Rules15x15>(spec, firstBlock, count, backend, out);
+    else playBlocks<StandardRules>(spec, firstBlock, count, backend, out);
+}
+
+static std::string cellName(uint8_t cell, int cols) {
+    if (cell == GOLDEN_SKIPPED) return "skip";
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "(%d,%d)", cell / cols, cell % cols);
+    return buf;
+}
+
+// Empty when the games match, otherwise where they first differ
+static std::string compareGame(const GoldenGame &want, const GoldenGame &got, bool compareMaps, int cols) {
+    char buf[160];
+    size_t n = want.shots.size() < got.shots.size() ? want.shots.size() : got.shots.size();
+    for (size_t k = 0; k < n; ++k)
+        if (want.shots[k] != got.shots[k]) {
+            std::snprintf(buf, sizeof(buf), "game %lld shot %zu: golden %s, got %s", want.game, k,
+                          cellName(want.shots[k], cols).c_str(), cellName(got.shots[k], cols).c_str());
+            return buf;
+        }
+    if (want.shots.size() != got.shots.size()) {
+        std::snprintf(buf, sizeof(buf), "game %lld: golden has %zu shots, got %zu", want.game, want.shots.size(),
+                      got.shots.size());
+        return buf;
+    }
+    if (compareMaps && want.mapDigest != got.mapDigest) {
+        std::snprintf(buf, sizeof(buf), "game %lld: same shots, live maps differ", want.game);
+        return buf;
+    }
+    return "";
+}
+
+GoldenReport compareGolden(const GoldenCorpus &golden, const std::vector<GoldenGame> &got, bool compareMaps) {
+    GoldenReport report;
+    report.games = static_cast<long long>(golden.played.size());
+    for (size_t i = 0; i < golden.played.size(); ++i) {
+        std::string diff;
+        if (i >= got.size() || got[i].game != golden.played[i].game) {
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "game %lld: not played", golden.played[i].game);
+            diff = buf;
+        } else {
+            diff = compareGame(golden.played[i], got[i], compareMaps, goldenCols(golden));
+        }
+        if (diff.empty()) continue;
+        if (report.mismatched++ == 0) report.firstMismatch = diff;
+    }
+    return report;
+}
+
+static const char HEX[] = "0123456789abcdef";
+
+static void appendHex(std::string &s, const uint8_t *bytes, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        s += HEX[bytes[i] >> 4];
+        s += HEX[bytes[i] & 15];
+    }
+}
+
+static bool parseHex(const char *s, size_t len, std::vector<uint8_t> &out) {
+    if (len % 2) return false;
+    out.resize(len / 2);
+    for (size_t i = 0; i < len; i += 2) {
+        const char *hi = std::strchr(HEX, s[i]), *lo = std::strchr(HEX, s[i + 1]);
+        if (!s[i] || !s[i + 1] || !hi || !lo) return false;
+        out[i / 2] = static_cast<uint8_t>((hi - HEX) << 4 | (lo - HEX));
+    }
+    return true;
+}
+
+std::string goldenToText(const GoldenCorpus &c) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "battleship-golden 4 seed=%llu games=%lld block=%d mc=%d prior=%d rules=%s\n",
+                  static_cast<unsigned long long>(c.seed), c.games, c.blockGames, c.mcIterations,
+                  c.learnPrior ? 1 : 0, c.rules.c_str());
+    std::string s = buf;
+    for (const GoldenGame &g : c.played) {
+        std::snprintf(buf, sizeof(buf), "g %lld %016llx ", g.game, static_cast<unsigned long long>(g.mapDigest));
+        s += buf;
+        appendHex(s, g.shots.data(), g.shots.size());
+        s += '\n';
+    }
+    return s;
+}
+
+bool goldenFromText(const std::string &text, GoldenCorpus &c) {
+    c = GoldenCorpus();
+    size_t pos = 0;
+    bool header = false;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (line.empty()) continue;
+        const char *p = line.c_str();
+        char *rest = nullptr;
+        if (!header) {
+            unsigned long long seed = 0;
+            long long games = 0;
+            int block = 0, mc = 0, prior = 0;
+            char rules[16] = "10x10";
+            // Version 3 files predate the rules field and version 2 files the prior
+            // field; they were played on the standard game without a prior
+            if ((std::sscanf(p, "battleship-golden 4 seed=%llu games=%lld block=%d mc=%d prior=%d rules=%15s", &seed,
+                             &games, &block, &mc, &prior, rules) != 6 &&
+                 std::sscanf(p, "battleship-golden 3 seed=%llu games=%lld block=%d mc=%d prior=%d", &seed, &games,
+                             &block, &mc, &prior) != 5 &&
+                 std::sscanf(p, "battleship-golden 2 seed=%llu games=%lld block=%d mc=%d", &seed, &games, &block,
+                             &mc) != 4) ||
+                block < 1 || mc < 0 || !isGoldenRuleSet(rules))
+                return false;
+            c.seed = seed;
+            c.games = games;
+            c.blockGames = block;
+            c.mcIterations = mc;
+            c.learnPrior = prior != 0;
+            c.rules = rules;
+            header = true;
+        } else if (p[0] == 'g' && p[1] == ' ') {
+            GoldenGame g;
+            g.game = std::strtoll(p + 2, &rest, 10);
+            g.mapDigest = std::strtoull(rest, &rest, 16);
+            while (*rest == ' ') ++rest;
+            if (!parseHex(rest, std::strlen(rest), g.shots)) return false;
+            c.played.push_back(std::move(g));
+        } else {
+            return false;
+        }
+    }
+    return header && static_cast<long long>(c.played.size()) == c.games;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Tournament.h"
+
+// Golden-output determinism harness.
+//
+// A golden corpus is games [0, games) of the sweep seeded by `seed`, played in
+// blocks of `blockGames` (each block one Tournament, so the learned prior
+// restarts as it does in sweeps) with `mcIterations` Monte Carlo samples and, with
+// `learnPrior`, the tournament's learned placement prior. The
+// reference is the scalar Tournament path with live maps on. For every game it
+// keeps every shot in order, plus a digest of the shooter's live map after each
+// shot, endgame Monte Carlo blends included. Corpora use at least
+// MC_PARALLEL_MIN_ITERATIONS samples so the sampler splits into chunks; the split
+// never depends on the thread pool, so every map must match exactly. (CUDA
+// builds sample with their own generator and are not covered.) A corpus is
+// played on one rule set, named by goldenRuleSets(); the default is the
+// standard game.
+
+enum GoldenBackend {
+    GOLDEN_SCALAR,      // Tournament::step, live maps compared
+    GOLDEN_BATCH,       // BatchTournament, one block per lane; shots only (lanes keep no live maps)
+};
+
+struct GoldenGame {
+    long long game = 0;
+    std::vector<uint8_t> shots;                 // row * cols + col, GOLDEN_SKIPPED for a skipped turn
+    uint64_t mapDigest = 0;                     // FNV-1a of the float32 live maps
+};
+const uint8_t GOLDEN_SKIPPED = 255;
+
+struct GoldenCorpus {
+    uint64_t seed = 0;
+    long long games = 0;
+    int blockGames = 0;
+    int mcIterations = 0;
+    bool learnPrior = false;
+    std::string rules = "10x10";                // one of goldenRuleSets()
+    std::vector<GoldenGame> played;             // by game index
+};
+
+// Names of the rule sets a corpus can be played on (FOR_EACH_GAME_RULES):
+// "10x10" (standard), "8x8", "12x12" and "15x15"
+const std::vector<std::string> &goldenRuleSets();
+bool isGoldenRuleSet(const std::string &rules);
+
+// Plays blocks [firstBlock, firstBlock + count) of the corpus on `backend` and
+// appends their games to out, in game order
+void playGoldenBlocks(const GoldenCorpus &spec, long long firstBlock, int count, GoldenBackend backend,
+                      std::vector<GoldenGame> &out);
+long long goldenBlocks(const GoldenCorpus &spec);
+
+struct GoldenReport {
+    long long games = 0;
+    long long mismatched = 0;                   // games with a different shot or map
+    std::string firstMismatch;                  // where the first mismatching game diverged
+};
+
+// Checks `got` (every game of the corpus, in order) against the golden games.
+// Map digests are compared only when compareMaps is set.
+GoldenReport compareGolden(const GoldenCorpus &golden, const std::vector<GoldenGame> &got, bool compareMaps);
+
+// Text form: a header line, then per game a line with the map digest and hex shots
+std::string goldenToText(const GoldenCorpus &c);
+bool goldenFromText(const std::string &text, GoldenCorpus &c);
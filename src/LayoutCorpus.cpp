@@ -0,0 +1,117 @@
+#include "LayoutCorpus.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char CORPUS_MAGIC[4] = {'B', 'S', 'F', 'L'};
+static const uint32_t CORPUS_VERSION = 1;
+static_assert(sizeof(FleetLayout) == NUM_SHIPS, "layout records are packed bytes");
+
+static void fillGeometry(LayoutCorpusHeader &h) {
+    h.rows = NUM_ROWS;
+    h.cols = NUM_COLS;
+    h.ships = NUM_SHIPS;
+    for (int s = 0; s < NUM_SHIPS; ++s) h.shipSizes[s] = static_cast<uint8_t>(SHIP_SIZES[s]);
+}
+
+static uint64_t fnv1a(uint64_t x, const void *data, size_t n) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < n; ++i) x = (x ^ p[i]) * 0x100000001b3ULL;
+    return x;
+}
+
+bool writeLayoutCorpus(const std::string &path, FleetBias bias, long long count, uint64_t seed) {
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    LayoutCorpusHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, CORPUS_MAGIC, 4);
+    h.version = CORPUS_VERSION;
+    h.bias = bias;
+    fillGeometry(h);
+    h.count = static_cast<uint64_t>(count);
+    h.seed = seed;
+    h.checksum = 0xcbf29ce484222325ULL;
+    // Header first with a placeholder checksum, rewritten once the records are out
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+
+    const FleetSampler &sampler = fleetSampler(bias);
+    std::vector<FleetLayout> chunk(65536);
+    for (long long i = 0; ok && i < count; ) {
+        size_t n = static_cast<size_t>(std::min<long long>(chunk.size(), count - i));
+        for (size_t k = 0; k < n; ++k, ++i) {
+            GameRng rng;
+            rng.seed(gameSeed(seed, i));
+            GameRngScope scope(rng);
+            char board[NUM_ROWS][NUM_COLS];
+            initializeBoard(board);
+            sampler.sample(board, &chunk[k]);
+        }
+        h.checksum = fnv1a(h.checksum, chunk.data(), n * sizeof(FleetLayout));
+        ok = std::fwrite(chunk.data(), sizeof(FleetLayout), n, f) == n;
+    }
+    ok = ok && std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = std::fclose(f) == 0 && ok;
+    return ok;
+}
+
+bool LayoutCorpus::open(const std::string &path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(LayoutCorpusHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    void *p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);        // the mapping keeps the file open
+    if (p == MAP_FAILED) return false;
+    map = p;
+    mapBytes = bytes;
+
+    std::memcpy(&header, map, sizeof(header));
+    LayoutCorpusHeader expect;
+    std::memset(&expect, 0, sizeof(expect));
+    fillGeometry(expect);
+    bool ok = std::memcmp(header.magic, CORPUS_MAGIC, 4) == 0 && header.version == CORPUS_VERSION &&
+              header.rows == expect.rows && header.cols == expect.cols && header.ships == expect.ships &&
+              std::memcmp(header.shipSizes, expect.shipSizes, sizeof(expect.shipSizes)) == 0 &&
+              header.count == (bytes - sizeof(header)) / sizeof(FleetLayout) &&
+              (bytes - sizeof(header)) % sizeof(FleetLayout) == 0;
+    const FleetLayout *records = reinterpret_cast<const FleetLayout *>(static_cast<const char *>(map) + sizeof(header));
+    if (ok) {
+        // Every index must name a placement; overlaps are caught when a board is laid out
+        const FleetSampler &sampler = fleetSampler(FLEET_UNIFORM);
+        for (uint64_t i = 0; ok && i < header.count; ++i)
+            for (int s = 0; s < NUM_SHIPS; ++s)
+                if (records[i].placement[s] >= sampler.ships[s].count) ok = false;
+        ok = ok && fnv1a(0xcbf29ce484222325ULL, records, header.count * sizeof(FleetLayout)) == header.checksum;
+    }
+    if (!ok) {
+        close();
+        return false;
+    }
+    layouts = records;
+    count = static_cast<long long>(header.count);
+    return true;
+}
+
+void LayoutCorpus::close() {
+    if (map) munmap(map, mapBytes);
+    map = nullptr;
+    mapBytes = 0;
+    layouts = nullptr;
+    count = 0;
+}
+
+std::string LayoutCorpus::id() const {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(header.checksum));
+    return buf;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "battleship.h"
+
+// Pregenerated fleet layouts in a memory-mapped file.
+//
+// A corpus is a header followed by `count` FleetLayout records (one placement
+// index per ship, 5 bytes a board). Layout i is drawn by the sampler for the
+// header's bias from gameSeed(seed, i), so (bias, seed, count) regenerate the same
+// file. Tournaments that draw their boards from a corpus (Tournament::layouts)
+// spend nothing on placement, and separate processes mapping the same file play
+// on exactly the same boards.
+
+struct LayoutCorpusHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t bias;              // FleetBias
+    uint8_t rows, cols, ships, pad;
+    uint8_t shipSizes[8];
+    uint64_t count;
+    uint64_t seed;
+    uint64_t checksum;          // FNV-1a of the layout records
+};
+
+// Writes `count` layouts drawn with `bias` from `seed` to `path`
+bool writeLayoutCorpus(const std::string &path, FleetBias bias, long long count, uint64_t seed);
+
+// Read-only mapping of a corpus file
+struct LayoutCorpus {
+    LayoutCorpusHeader header{};
+    const FleetLayout *layouts = nullptr;
+    long long count = 0;
+
+    LayoutCorpus() = default;
+    LayoutCorpus(const LayoutCorpus &) = delete;
+    LayoutCorpus &operator=(const LayoutCorpus &) = delete;
+    ~LayoutCorpus() { close(); }
+
+    // Maps `path` and checks the header, the board geometry, the size and every
+    // placement index; fails (and stays closed) on any mismatch
+    bool open(const std::string &path);
+    void close();
+    // Checksum as 16 hex digits (identifies the boards, e.g. in result cache keys)
+    std::string id() const;
+
+private:
+    void *map = nullptr;
+    size_t mapBytes = 0;
+};
@@ -1,6 +1,15 @@
 #include "MLforAI.h"
 #include "battleship.h"
-#if defined(USE_CUDA)
+#include "simd_kernels.h"
+#include "Metrics.h"
+#include "RulesKernels.h"
+#ifdef BATTLESHIP_THREADS
+#include "WorkerPool.h"
+#endif
+#include <chrono>
+#include <cstring>
+#include <memory>
+#ifndef __EMSCRIPTEN__
 #include "mc_cuda.h"
 #endif
 
@@ -12,6 +21,53 @@ AIWeights gAIWeights{};
 void setAIWeights(const AIWeights &w) { gAIWeights = w; }
 void getAIWeights(AIWeights &out) { out = gAIWeights; }
 
+static thread_local const AIWeights *tActiveWeights = nullptr;
+
+const AIWeights &aiWeights() { return tActiveWeights ? *tActiveWeights : gAIWeights; }
+
+AIWeightsScope::AIWeightsScope(const AIWeights *w) : previous(tActiveWeights) {
+    if (w) tActiveWeights = w;
+}
+AIWeightsScope::~AIWeightsScope() { tActiveWeights = previous; }
+
+void weightsToArray(const AIWeights &w, double out[AI_WEIGHT_COUNT]) {
+    out[0] = w.globalAlphaEarly;
+    out[1] = w.globalAlphaLate;
+    out[2] = w.liveDecayFactor;
+    out[3] = w.tacticalLiveBonus;
+    out[4] = w.parityBonus;
+    out[5] = w.parityPenalty;
+    out[6] = w.adjHitBonus;
+    out[7] = w.adjLineBonus;
+    out[8] = w.diagHitBonus;
+    out[9] = w.fitScoreNearAdjFactor;
+    out[10] = w.fitScoreBaseFactor;
+    out[11] = w.noFitPenalty;
+    out[12] = w.placementHitMultiplier;
+    out[13] = w.mcIterations;
+    out[14] = w.mcBlendRatio;
+    out[15] = w.mcBlendThresholdCells;
+}
+
+void weightsFromArray(const double in[AI_WEIGHT_COUNT], AIWeights &w) {
+    w.globalAlphaEarly = in[0];
+    w.globalAlphaLate  = in[1];
+    w.liveDecayFactor  = in[2];
+    w.tacticalLiveBonus = in[3];
+    w.parityBonus       = in[4];
+    w.parityPenalty     = in[5];
+    w.adjHitBonus       = in[6];
+    w.adjLineBonus      = in[7];
+    w.diagHitBonus      = in[8];
+    w.fitScoreNearAdjFactor = in[9];
+    w.fitScoreBaseFactor    = in[10];
+    w.noFitPenalty      = in[11];
+    w.placementHitMultiplier = in[12];
+    w.mcIterations      = static_cast<int>(in[13]);
+    w.mcBlendRatio      = in[14];
+    w.mcBlendThresholdCells = static_cast<int>(in[15]);
+}
+
 // learnFromLog removed for WASM - no file I/O
 // Learning happens in-memory during the tournament
 
@@ -50,14 +106,15 @@ void computeProbabilities(int hitCount[NUM_ROWS][NUM_COLS],
  * @param hitProb The hit probabilities for each cell on the board
  * @return The coordinates of the cell with the highest hit probability
  */
-pair<int,int> getSmartMove(const char board[NUM_ROWS][NUM_COLS],
-                           double hitProb[NUM_ROWS][NUM_COLS]) {
+template <class RulesT>
+pair<int,int> getSmartMove(const char board[RulesT::ROWS][RulesT::COLS],
+                           double hitProb[RulesT::ROWS][RulesT::COLS]) {
     int bestRow = -1, bestCol = -1;
     double bestScore = -1.0;
 
-    for (int r = 0; r < NUM_ROWS; r++) {
-        for (int c = 0; c < NUM_COLS; c++) {
-            if (checkShotIsAvailable(board, r, c)) {
+    for (int r = 0; r < RulesT::ROWS; r++) {
+        for (int c = 0; c < RulesT::COLS; c++) {
+            if (checkShotIsAvailable<RulesT>(board, r, c)) {
                 if (hitProb[r][c] > bestScore) {
                     bestScore = hitProb[r][c];
                     bestRow = r;
@@ -86,19 +143,21 @@ void saveHeatmap(const string &filename, double hitProb[NUM_ROWS][NUM_COLS]) {
 }
 
 
-void updateLiveHeatmap(const char board[NUM_ROWS][NUM_COLS],
-                       double liveProb[NUM_ROWS][NUM_COLS],
-                       const int remaining[NUM_SHIPS]) {
+template <class RulesT>
+void updateLiveHeatmap(const char board[RulesT::ROWS][RulesT::COLS],
+                       double liveProb[RulesT::ROWS][RulesT::COLS],
+                       const int remaining[RulesT::SHIPS]) {
+    ProfileScope profile(PROFILE_LIVE_HEATMAP);
     // Reset liveProb
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             liveProb[r][c] = 0.0;
 
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             if (board[r][c] != 'X') continue;
 
-            for (int i = 0; i < NUM_SHIPS; ++i) {
+            for (int i = 0; i < RulesT::SHIPS; ++i) {
                 if (remaining[i] == 0) continue;
                 int len = remaining[i];
 
@@ -114,9 +173,9 @@ void updateLiveHeatmap(const char board[NUM_ROWS][NUM_COLS],
                         for (int k = 0; k < len; ++k) {
                             int nr = startR + k * dr;
                             int nc = startC + k * dc;
-                            if (nr < 0 || nr >= NUM_ROWS || nc < 0 || nc >= NUM_COLS)
+                            if (nr < 0 || nr >= RulesT::ROWS || nc < 0 || nc >= RulesT::COLS)
                                 { valid = false; break; }
-                            if (board[nr][nc] == 'm') { valid = false; break; }
+                            if (board[nr][nc] == 'm' || board[nr][nc] == SUNK) { valid = false; break; }
                         }
 
                         if (valid) {
@@ -135,13 +194,13 @@ void updateLiveHeatmap(const char board[NUM_ROWS][NUM_COLS],
 
     // Normalize liveProb
     double maxVal = 0.0;
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             if (liveProb[r][c] > maxVal) maxVal = liveProb[r][c];
 
     if (maxVal > 0.0) {
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
                 liveProb[r][c] /= maxVal;
     }
 }
@@ -152,31 +211,29 @@ void updateLiveHeatmap(const char board[NUM_ROWS][NUM_COLS],
 
 
 // Check if a cell is within bounds and still available
-bool isCellAvailable(const char board[NUM_ROWS][NUM_COLS], int r, int c) {
-    return r >= 0 && r < NUM_ROWS && c >= 0 && c < NUM_COLS
-           && checkShotIsAvailable(board, r, c);
+template <class RulesT>
+bool isCellAvailable(const char board[RulesT::ROWS][RulesT::COLS], int r, int c) {
+    return r >= 0 && r < RulesT::ROWS && c >= 0 && c < RulesT::COLS
+           && checkShotIsAvailable<RulesT>(board, r, c);
 }
 
 // Queue up neighbors (up, down, left, right) after a hit
-static bool inQueue(const TargetState &ts, int r, int c) {
-    for (auto &p : ts.queue) if (p.first == r && p.second == c) return true;
-    return false;
-}
-
-void enqueueNeighbors(TargetState &ts, const char board[NUM_ROWS][NUM_COLS], int r, int c) {
+template <class RulesT>
+void enqueueNeighbors(BasicTargetState<RulesT> &ts, const char board[RulesT::ROWS][RulesT::COLS], int r, int c) {
     const int dr[4] = {-1, 1, 0, 0};
     const int dc[4] = {0, 0, -1, 1};
     for (int k = 0; k < 4; ++k) {
         int nr = r + dr[k], nc = c + dc[k];
-        if (isCellAvailable(board, nr, nc)) {
-            if (!inQueue(ts, nr, nc)) ts.queue.emplace_back(nr, nc);
+        if (isCellAvailable<RulesT>(board, nr, nc)) {
+            ts.queue.push(nr, nc);
         }
     }
 }
 
 // Extend in a line along the current orientation, both directions
-void enqueueOrientedLine(TargetState &ts,
-                         const char targetBoard[NUM_ROWS][NUM_COLS]) {
+template <class RulesT>
+void enqueueOrientedLine(BasicTargetState<RulesT> &ts,
+                         const char targetBoard[RulesT::ROWS][RulesT::COLS]) {
     int r = ts.lastHitRow;
     int c = ts.lastHitCol;
 
@@ -185,61 +242,208 @@ void enqueueOrientedLine(TargetState &ts,
     if (ts.orientation == 1) { // horizontal
         // left
         for (int cc = c - 1; cc >= 0; --cc) {
-            if (checkShotIsAvailable(targetBoard, r, cc)) {
-                if (!inQueue(ts, r, cc)) ts.queue.push_back({r, cc});
+            if (checkShotIsAvailable<RulesT>(targetBoard, r, cc)) {
+                ts.queue.push(r, cc);
             } else if (targetBoard[r][cc] != 'X') break;
         }
         // right
-        for (int cc = c + 1; cc < NUM_COLS; ++cc) {
-            if (checkShotIsAvailable(targetBoard, r, cc)) {
-                if (!inQueue(ts, r, cc)) ts.queue.push_back({r, cc});
+        for (int cc = c + 1; cc < RulesT::COLS; ++cc) {
+            if (checkShotIsAvailable<RulesT>(targetBoard, r, cc)) {
+                ts.queue.push(r, cc);
             } else if (targetBoard[r][cc] != 'X') break;
         }
     } else if (ts.orientation == 2) { // vertical
         // up
         for (int rr = r - 1; rr >= 0; --rr) {
-            if (checkShotIsAvailable(targetBoard, rr, c)) {
-                if (!inQueue(ts, rr, c)) ts.queue.push_back({rr, c});
+            if (checkShotIsAvailable<RulesT>(targetBoard, rr, c)) {
+                ts.queue.push(rr, c);
             } else if (targetBoard[rr][c] != 'X') break;
         }
         // down
-        for (int rr = r + 1; rr < NUM_ROWS; ++rr) {
-            if (checkShotIsAvailable(targetBoard, rr, c)) {
-                if (!inQueue(ts, rr, c)) ts.queue.push_back({rr, c});
+        for (int rr = r + 1; rr < RulesT::ROWS; ++rr) {
+            if (checkShotIsAvailable<RulesT>(targetBoard, rr, c)) {
+                ts.queue.push(rr, c);
             } else if (targetBoard[rr][c] != 'X') break;
         }
     }
 }
 
+template <class RulesT>
+static std::pair<int,int> pickScoredMove(const char board[RulesT::ROWS][RulesT::COLS],
+                                         double globalProb[RulesT::ROWS][RulesT::COLS],
+                                         double liveProb[RulesT::ROWS][RulesT::COLS],
+                                         BasicTargetState<RulesT> &ts,
+                                         const int remaining[RulesT::SHIPS],
+                                         int turn);
+
+template <class RulesT>
+static void placementMapFromCounts(const char boardView[RulesT::ROWS][RulesT::COLS], const int counts[RulesT::ROWS][RulesT::COLS],
+                                   double outProb[RulesT::ROWS][RulesT::COLS]);
+
+// The shooter's view of the target board: hits, misses, unknown
+template <class RulesT>
+static void shooterView(const char board[RulesT::ROWS][RulesT::COLS], char view[RulesT::ROWS][RulesT::COLS]) {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            view[r][c] = (board[r][c] == 'X' || board[r][c] == 'm' || board[r][c] == SUNK) ? board[r][c] : '-';
+}
+
+// Move-map pipeline. Every move selector builds liveProb in the same stages:
+//   0. hit-neighbourhood heatmap (updateLiveHeatmap)
+//   1. placement enumeration, blended in at PLACEMENT_BLEND_RATIO
+//   2. endgame Monte Carlo, blended in at mcBlendRatio
+// chooseAIMove runs all of them and chooseAIMoveWithin runs the prefix that fits
+// its budget, so an unlimited budget plays exactly the unbudgeted move.
+template <class RulesT>
+static void blendPlacementMap(const double placement[RulesT::ROWS][RulesT::COLS], double liveProb[RulesT::ROWS][RulesT::COLS]) {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            liveProb[r][c] = (1.0 - PLACEMENT_BLEND_RATIO) * liveProb[r][c] + PLACEMENT_BLEND_RATIO * placement[r][c];
+}
+
+template <class RulesT>
+static void blendPlacement(const char view[RulesT::ROWS][RulesT::COLS], const int remaining[RulesT::SHIPS],
+                           double liveProb[RulesT::ROWS][RulesT::COLS]) {
+    double placement[RulesT::ROWS][RulesT::COLS];
+    computePlacementProbabilities<RulesT>(view, remaining, placement);
+    blendPlacementMap<RulesT>(placement, liveProb);
+}
+
+// Samples stage 2 takes for this position; 0 when it does not run. With a single
+// ship left the placement map is already exact.
+template <class RulesT>
+static int endgameMcIterations(const int remaining[RulesT::SHIPS]) {
+    const AIWeights &W = aiWeights();
+    int shipsLeft = 0, cellsLeft = 0;
+    for (int i = 0; i < RulesT::SHIPS; ++i)
+        if (remaining[i] > 0) { shipsLeft++; cellsLeft += remaining[i]; }
+    if (shipsLeft <= 1 || cellsLeft > W.mcBlendThresholdCells || W.mcBlendRatio <= 0.0) return 0;
+    return W.mcIterations > 0 ? W.mcIterations : 0;
+}
+
+// The samples come from a generator seeded by the position rather than the
+// round's stream, so the move does not depend on what else drew from that stream
+// (the live-map refresh samples too) and lanes, replays and the move server agree.
+template <class RulesT>
+static void blendMonteCarlo(const char view[RulesT::ROWS][RulesT::COLS], const int remaining[RulesT::SHIPS], int iterations,
+                            double liveProb[RulesT::ROWS][RulesT::COLS]) {
+    const AIWeights &W = aiWeights();
+    uint64_t h = 1469598103934665603ULL;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) h = (h ^ static_cast<unsigned char>(view[r][c])) * 1099511628211ULL;
+    for (int i = 0; i < RulesT::SHIPS; ++i) h = (h ^ static_cast<unsigned>(remaining[i])) * 1099511628211ULL;
+    GameRng rng;
+    rng.seed(h);
+    GameRngScope scope(rng);
+    double mcMap[RulesT::ROWS][RulesT::COLS];
+    monteCarloProbabilities<RulesT>(view, remaining, iterations, mcMap);
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            liveProb[r][c] = (1.0 - W.mcBlendRatio) * liveProb[r][c] + W.mcBlendRatio * mcMap[r][c];
+}
+
+template <class RulesT>
+static void refineMoveMap(const char board[RulesT::ROWS][RulesT::COLS], double liveProb[RulesT::ROWS][RulesT::COLS],
+                          const int remaining[RulesT::SHIPS]) {
+    updateLiveHeatmap<RulesT>(board, liveProb, remaining);
+    char view[RulesT::ROWS][RulesT::COLS];
+    shooterView<RulesT>(board, view);
+    blendPlacement<RulesT>(view, remaining, liveProb);
+    int iterations = endgameMcIterations<RulesT>(remaining);
+    if (iterations > 0) blendMonteCarlo<RulesT>(view, remaining, iterations, liveProb);
+}
+
 // AI move selector using parity + heatmap (search) and weighted target mode
-std::pair<int,int> chooseAIMove(const char board[NUM_ROWS][NUM_COLS],
-                                double globalProb[NUM_ROWS][NUM_COLS],
-                                double liveProb[NUM_ROWS][NUM_COLS],
-                                TargetState &ts,
-                                const int remaining[NUM_SHIPS],
+template <class RulesT>
+std::pair<int,int> chooseAIMove(const char board[RulesT::ROWS][RulesT::COLS],
+                                double globalProb[RulesT::ROWS][RulesT::COLS],
+                                double liveProb[RulesT::ROWS][RulesT::COLS],
+                                BasicTargetState<RulesT> &ts,
+                                const int remaining[RulesT::SHIPS],
                                 int turn) {
+    ProfileScope profile(PROFILE_CHOOSE_MOVE);
+    refineMoveMap<RulesT>(board, liveProb, remaining);
+    return pickScoredMove<RulesT>(board, globalProb, liveProb, ts, remaining, turn);
+}
+
+// Per-thread running estimates of what each refinement costs, used to decide
+// whether the next tier still fits in the remaining budget.
+static thread_local double tPlacementMs = 0.05;
+static thread_local double tMcIterMs = 0.002;
+static thread_local double tPickMs = 0.02;
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void trackCost(double &estimate, double sample) {
+    estimate = 0.8 * estimate + 0.2 * sample;
+}
 
-    updateLiveHeatmap(board, liveProb, remaining);
+template <class RulesT>
+std::pair<int,int> chooseAIMoveWithin(const char board[RulesT::ROWS][RulesT::COLS],
+                                      double globalProb[RulesT::ROWS][RulesT::COLS],
+                                      double liveProb[RulesT::ROWS][RulesT::COLS],
+                                      BasicTargetState<RulesT> &ts,
+                                      const int remaining[RulesT::SHIPS],
+                                      int turn,
+                                      double budgetMs,
+                                      int *tierReached) {
+    ProfileScope profile(PROFILE_CHOOSE_MOVE);
+    auto t0 = std::chrono::steady_clock::now();
+    int tier = MOVE_TIER_HEURISTIC;
+
+    updateLiveHeatmap<RulesT>(board, liveProb, remaining);
+    char view[RulesT::ROWS][RulesT::COLS];
+    shooterView<RulesT>(board, view);
+
+    if (msSince(t0) + tPlacementMs + tPickMs <= budgetMs) {
+        auto t1 = std::chrono::steady_clock::now();
+        blendPlacement<RulesT>(view, remaining, liveProb);
+        trackCost(tPlacementMs, msSince(t1));
+        tier = MOVE_TIER_PLACEMENT;
+
+        // Stage 2 runs only with every sample chooseAIMove would take: a map from
+        // fewer samples is a different map, not a cheaper version of the same one
+        int iterations = endgameMcIterations<RulesT>(remaining);
+        if (iterations == 0) {
+            tier = MOVE_TIER_FULL;
+        } else if (msSince(t0) + iterations * tMcIterMs + tPickMs <= budgetMs) {
+            auto t2 = std::chrono::steady_clock::now();
+            blendMonteCarlo<RulesT>(view, remaining, iterations, liveProb);
+            trackCost(tMcIterMs, msSince(t2) / iterations);
+            tier = MOVE_TIER_FULL;
+        }
+    }
 
+    auto tp = std::chrono::steady_clock::now();
+    std::pair<int,int> mv = pickScoredMove<RulesT>(board, globalProb, liveProb, ts, remaining, turn);
+    trackCost(tPickMs, msSince(tp));
+    if (tierReached) *tierReached = tier;
+    return mv;
+}
 
+// Target-queue / search-mode selection; score(r, c) rates a cell as scoreCell does
+template <class RulesT, class ScoreFn>
+static std::pair<int,int> pickMove(const char board[RulesT::ROWS][RulesT::COLS], BasicTargetState<RulesT> &ts,
+                                   ScoreFn score) {
     // --- Target mode ---
     if (ts.active && !ts.queue.empty()) {
         pair<int,int> best = {-1,-1};
         double bestScore = -1.0;
-        for (auto &mv : ts.queue) {
-            int r = mv.first, c = mv.second;
-            if (!checkShotIsAvailable(board, r, c)) continue;
-            double s = scoreCell(r, c, board, globalProb, liveProb, remaining, turn);
+        for (const BoardCell &mv : ts.queue) {
+            int r = mv.row, c = mv.col;
+            if (!checkShotIsAvailable<RulesT>(board, r, c)) continue;
+            double s = score(r, c);
             if (s > bestScore) {
                 bestScore = s;
-                best = mv;
+                best = {r, c};
             }
         }
         // remove chosen cell from queue (if any) and return
         if (best.first != -1) {
             // remove chosen element only
-            auto it = std::remove_if(ts.queue.begin(), ts.queue.end(), [&](auto &p){return p.first==best.first && p.second==best.second;});
-            ts.queue.erase(it, ts.queue.end());
+            ts.queue.remove(best.first, best.second);
             return best;
         }
         // If queue was invalid, reset targeting
@@ -251,19 +455,19 @@ std::pair<int,int> chooseAIMove(const char board[NUM_ROWS][NUM_COLS],
     pair<int,int> bestMove = {-1,-1};
 
     // Iterate cells in a center-out spiral so ties and small score differences bias toward center
-    int centerR = NUM_ROWS / 2 - (NUM_ROWS % 2 == 0 ? 1 : 0);
-    int centerC = NUM_COLS / 2 - (NUM_COLS % 2 == 0 ? 1 : 0);
+    int centerR = RulesT::ROWS / 2 - (RulesT::ROWS % 2 == 0 ? 1 : 0);
+    int centerC = RulesT::COLS / 2 - (RulesT::COLS % 2 == 0 ? 1 : 0);
     int layer = 0;
     int found = 0;
-    while (layer <= max(NUM_ROWS, NUM_COLS) && found < NUM_ROWS * NUM_COLS) {
+    while (layer <= max(RulesT::ROWS, RulesT::COLS) && found < RulesT::ROWS * RulesT::COLS) {
         for (int dr = -layer; dr <= layer; ++dr) {
             for (int dc = -layer; dc <= layer; ++dc) {
                 if (abs(dr) != layer && abs(dc) != layer) continue;
                 int r = centerR + dr;
                 int c = centerC + dc;
-                if (r < 0 || r >= NUM_ROWS || c < 0 || c >= NUM_COLS) continue;
+                if (r < 0 || r >= RulesT::ROWS || c < 0 || c >= RulesT::COLS) continue;
                 found++;
-                double s = scoreCell(r, c, board, globalProb, liveProb, remaining, turn);
+                double s = score(r, c);
                 if (s > bestScore) {
                     bestScore = s;
                     bestMove = {r, c};
@@ -275,9 +479,9 @@ std::pair<int,int> chooseAIMove(const char board[NUM_ROWS][NUM_COLS],
 
     // Fallback if nothing valid
     if (bestMove.first == -1) {
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
-                if (checkShotIsAvailable(board, r, c))
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
+                if (checkShotIsAvailable<RulesT>(board, r, c))
                     return {r, c};
     }
     return bestMove;
@@ -288,20 +492,367 @@ std::pair<int,int> chooseAIMove(const char board[NUM_ROWS][NUM_COLS],
 }
 
 
+// Target-queue / search-mode selection over an already prepared live map
+template <class RulesT>
+static std::pair<int,int> pickScoredMove(const char board[RulesT::ROWS][RulesT::COLS],
+                                         double globalProb[RulesT::ROWS][RulesT::COLS],
+                                         double liveProb[RulesT::ROWS][RulesT::COLS],
+                                         BasicTargetState<RulesT> &ts,
+                                         const int remaining[RulesT::SHIPS],
+                                         int turn) {
+    return pickMove<RulesT>(board, ts, [&](int r, int c) {
+        return scoreCell<RulesT>(r, c, board, globalProb, liveProb, remaining, turn);
+    });
+}
+
+// Start cells where a ship of `len` fits along each line, given the line's blocked
+// cells (bit i of blocked[line] <=> cell i of the line is blocked)
+template <class Mask>
+static void fitStarts(const Mask blocked[], int lines, int lineLen, int len, Mask out[]) {
+    if (len <= 0 || len > lineLen) {
+        for (int i = 0; i < lines; ++i) out[i] = 0;
+        return;
+    }
+    Mask starts = static_cast<Mask>((uint64_t(1) << (lineLen - len + 1)) - 1);
+    for (int i = 0; i < lines; ++i) {
+        Mask covered = 0;
+        for (int k = 0; k < len; ++k) covered |= static_cast<Mask>(blocked[i] >> k);
+        out[i] = static_cast<Mask>(~covered & starts);
+    }
+}
+
+// Two lanes per vector (GCC/Clang vector extensions: SSE2 natively, WASM SIMD128
+// with -msimd128, plain scalar code elsewhere)
+typedef double LaneD __attribute__((vector_size(16)));
+typedef int64_t LaneI __attribute__((vector_size(16)));
+const int LANE_WIDTH = 2;
+static_assert(MOVE_LANES % LANE_WIDTH == 0, "MOVE_LANES must be a multiple of the vector width");
+// Placement counting works on 32-bit lanes, four per vector
+typedef int32_t LaneN __attribute__((vector_size(16)));
+const int COUNT_WIDTH = 4;
+static_assert(MOVE_LANES % COUNT_WIDTH == 0, "MOVE_LANES must be a multiple of the count vector width");
+
+static inline LaneD loadLanes(const double *p) { LaneD v; std::memcpy(&v, p, sizeof(v)); return v; }
+static inline LaneI loadLanes(const int64_t *p) { LaneI v; std::memcpy(&v, p, sizeof(v)); return v; }
+static inline LaneN loadLanes(const int32_t *p) { LaneN v; std::memcpy(&v, p, sizeof(v)); return v; }
+static inline void storeLanes(int32_t *p, LaneN v) { std::memcpy(p, &v, sizeof(v)); }
+static inline LaneD splat(double x) { return LaneD{x, x}; }
+static inline LaneN splatN(int32_t x) { return LaneN{x, x, x, x}; }
+// x where the mask is set, +0.0 elsewhere (adding +0.0 leaves a sum unchanged)
+static inline LaneD keep(LaneD x, LaneI mask) { return (LaneD)((LaneI)x & mask); }
+
+// Lane-major working set of chooseAIMovesLanes: [..][lane]. Board facts are row
+// and column bitmasks, so one shift tests a cell in every lane. Padding lanes are
+// zero and never read back. At about 70 KB it is too big for a stack frame (WASM
+// builds get a 64 KB stack), so each thread keeps one on the heap.
+template <class RulesT>
+struct LaneScratch {
+    static const int CELLS = RulesT::CELLS, MAX_LEN = RulesT::LINE;
+    static_assert(MAX_LEN < 31, "placement counting shifts a line's mask in 32-bit lanes");
+    typedef typename RulesT::LineMask Mask;
+
+    double global[CELLS][MOVE_LANES], live[CELLS][MOVE_LANES];
+    double score[CELLS][MOVE_LANES];
+    int64_t hitRows[RulesT::ROWS + 4][MOVE_LANES];         // column c at bit c + 2; two empty rows above and below
+    int64_t fitRows[RulesT::SHIPS + 1][RulesT::ROWS][MOVE_LANES];  // horizontal starts; [RulesT::SHIPS] smallest ship
+    int64_t fitCols[RulesT::SHIPS + 1][RulesT::COLS][MOVE_LANES];  // vertical starts, bit = row
+    double shipW[RulesT::SHIPS][MOVE_LANES];
+    double fitDiv[MOVE_LANES], alpha[MOVE_LANES], beta[MOVE_LANES], decay[MOVE_LANES];
+    double parity[2][MOVE_LANES];
+    Mask availRows[MOVE_LANES][RulesT::ROWS];
+    uint8_t adjHits[MOVE_LANES][CELLS];
+
+    // Placement counting: blocked (miss or sunk) and hit cells, remaining ships by
+    // length, and the resulting per-cell weights
+    int32_t blockRows[RulesT::ROWS][MOVE_LANES], blockCols[RulesT::COLS][MOVE_LANES];
+    int32_t hitMaskRows[RulesT::ROWS][MOVE_LANES], hitMaskCols[RulesT::COLS][MOVE_LANES];
+    int32_t shipsOfLen[MAX_LEN + 1][MOVE_LANES];
+    int32_t counts[CELLS][MOVE_LANES];
+};
+
+template <class RulesT>
+static LaneScratch<RulesT> &laneScratch() {
+    static thread_local std::unique_ptr<LaneScratch<RulesT>> scratch;
+    if (!scratch) scratch.reset(new LaneScratch<RulesT>);
+    return *scratch;
+}
+
+// Row and column masks of a bitboard (cols[c] bit r <=> cell (r, c) is set)
+template <class RulesT>
+static void bitboardMasks(const BasicBitboard<RulesT::CELLS> &b, typename RulesT::LineMask rows[RulesT::ROWS],
+                          typename RulesT::LineMask cols[RulesT::COLS]) {
+    typedef typename RulesT::LineMask Mask;
+    const int words = BasicBitboard<RulesT::CELLS>::WORDS;
+    for (int c = 0; c < RulesT::COLS; ++c) cols[c] = 0;
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        const int first = r * RulesT::COLS, word = first >> 6, bit = first & 63;
+        uint64_t m = b.w[word] >> bit;
+        if (bit + RulesT::COLS > 64 && word + 1 < words) m |= b.w[word + 1] << (64 - bit);
+        rows[r] = static_cast<Mask>(m & ((uint64_t(1) << RulesT::COLS) - 1));
+        for (uint32_t k = rows[r]; k; k &= k - 1)
+            cols[__builtin_ctz(k)] |= static_cast<Mask>(1u << r);
+    }
+}
+
+// One orientation of placementCountsLanes: every line of `lines` cells holds
+// placements of `len` at each start. Line i's cell k is counts[i * lineStep + k * cellStep].
+template <class RulesT>
+static void countLinePlacements(LaneScratch<RulesT> &s, int g, int len, LaneN mult, const int32_t (*block)[MOVE_LANES],
+                                const int32_t (*hits)[MOVE_LANES], int lines, int lineLen, int lineStep,
+                                int cellStep, const int hitWeight[]) {
+    const int32_t span = static_cast<int32_t>((uint64_t(1) << len) - 1);
+    const LaneN one = splatN(1), zero = splatN(0), base = splatN(hitWeight[0]) * mult;
+    for (int i = 0; i < lines; ++i) {
+        const LaneN bl = loadLanes(block[i] + g), hl = loadLanes(hits[i] + g);
+        const bool anyHit = (hl[0] | hl[1] | hl[2] | hl[3]) != 0;
+        for (int start = 0; start + len <= lineLen; ++start) {
+            LaneN open = ((bl >> start) & span) == zero;
+            if (!(open[0] | open[1] | open[2] | open[3])) continue;
+            LaneN w = base;
+            if (anyHit) {
+                // Hits under the span, then the weight of that many hits
+                LaneN h = (hl >> start) & span, covered = zero;
+                for (int k = 0; k < len; ++k) covered += (h >> k) & one;
+                w = splatN(hitWeight[0]);
+                for (int k = 1; k <= len; ++k) w += (covered >= splatN(k)) & splatN(hitWeight[k] - hitWeight[k - 1]);
+                w *= mult;
+            }
+            w &= open;
+            int32_t *cell = s.counts[i * lineStep + start * cellStep] + g;
+            for (int k = 0; k < len; ++k, cell += cellStep * MOVE_LANES) storeLanes(cell, loadLanes(cell) + w);
+        }
+    }
+}
+
+// placementCounts for every lane at once, from the lanes' block and hit masks.
+// Ships are grouped by length: a length's span is the same mask in every lane, and
+// a lane scales each placement's weight by how many of its ships have that length.
+// The sums are integers, so each lane's counts equal placementCounts' exactly.
+template <class RulesT>
+static void placementCountsLanes(LaneScratch<RulesT> &s, int padded, double hitMultiplier) {
+    ProfileScope profile(PROFILE_PLACEMENT);
+    const int MAX_LEN = LaneScratch<RulesT>::MAX_LEN;
+    int hitWeight[MAX_LEN + 1];
+    for (int k = 0; k <= MAX_LEN; ++k) hitWeight[k] = static_cast<int>(1.0 + hitMultiplier * k);
+    std::memset(s.counts, 0, sizeof(s.counts));
+    for (int g = 0; g < padded; g += COUNT_WIDTH) {
+        for (int len = 1; len <= MAX_LEN; ++len) {
+            const LaneN mult = loadLanes(s.shipsOfLen[len] + g);
+            if (!(mult[0] | mult[1] | mult[2] | mult[3])) continue;
+            if (len <= RulesT::COLS)
+                countLinePlacements(s, g, len, mult, s.blockRows, s.hitMaskRows, RulesT::ROWS, RulesT::COLS, RulesT::COLS, 1,
+                                    hitWeight);
+            if (len <= RulesT::ROWS)
+                countLinePlacements(s, g, len, mult, s.blockCols, s.hitMaskCols, RulesT::COLS, RulesT::ROWS, 1, RulesT::COLS,
+                                    hitWeight);
+        }
+    }
+}
+
+template <class RulesT>
+void chooseAIMovesLanes(const BasicMoveLane<RulesT> lanes[], int count, std::pair<int,int> moves[]) {
+    ProfileScope profile(PROFILE_CHOOSE_MOVE);
+    typedef typename RulesT::LineMask Mask;
+    const AIWeights &W = aiWeights();
+    const int CELLS = RulesT::CELLS, MAX_LEN = RulesT::LINE;
+    if (count > MOVE_LANES) count = MOVE_LANES;
+    const int padded = (count + COUNT_WIDTH - 1) / COUNT_WIDTH * COUNT_WIDTH;
+    LaneScratch<RulesT> &s = laneScratch<RulesT>();
+
+    // Stage 0 of the move map and the board masks, lane by lane. Masks come from
+    // the round's bitboards when the lane has them (fire() updates those shot by
+    // shot), otherwise from the board.
+    for (int l = 0; l < padded; ++l) {
+        if (l >= count) {
+            for (int cell = 0; cell < CELLS; ++cell) s.global[cell][l] = s.live[cell][l] = 0.0;
+            for (int r = 0; r < RulesT::ROWS + 4; ++r) s.hitRows[r][l] = 0;
+            for (int i = 0; i <= RulesT::SHIPS; ++i) {
+                for (int r = 0; r < RulesT::ROWS; ++r) s.fitRows[i][r][l] = 0;
+                for (int c = 0; c < RulesT::COLS; ++c) s.fitCols[i][c][l] = 0;
+                if (i < RulesT::SHIPS) s.shipW[i][l] = 0.0;
+            }
+            for (int r = 0; r < RulesT::ROWS; ++r) s.blockRows[r][l] = s.hitMaskRows[r][l] = 0;
+            for (int c = 0; c < RulesT::COLS; ++c) s.blockCols[c][l] = s.hitMaskCols[c][l] = 0;
+            for (int len = 0; len <= MAX_LEN; ++len) s.shipsOfLen[len][l] = 0;
+            s.fitDiv[l] = 1.0;
+            s.alpha[l] = s.beta[l] = s.decay[l] = s.parity[0][l] = s.parity[1][l] = 0.0;
+            continue;
+        }
+        const BasicMoveLane<RulesT> &in = lanes[l];
+        updateLiveHeatmap<RulesT>(in.board, in.liveProb, in.remaining);
+
+        // Misses and resolved sunk cells block ships; hidden ships and hits do not
+        Mask blockRows[RulesT::ROWS], blockCols[RulesT::COLS], hitR[RulesT::ROWS], hitC[RulesT::COLS];
+        if (in.hits && in.misses && in.sunk) {
+            BasicBitboard<RulesT::CELLS> blocked = *in.misses, hit = *in.hits;
+            blocked |= *in.sunk;
+            for (int w = 0; w < BasicBitboard<RulesT::CELLS>::WORDS; ++w) hit.w[w] &= ~in.sunk->w[w];
+            bitboardMasks<RulesT>(blocked, blockRows, blockCols);
+            bitboardMasks<RulesT>(hit, hitR, hitC);
+        } else {
+            Mask sunkRows[RulesT::ROWS], sunkCols[RulesT::COLS];
+            boardMasks<RulesT>(in.board, MISS, blockRows, blockCols);
+            boardMasks<RulesT>(in.board, SUNK, sunkRows, sunkCols);
+            boardMasks<RulesT>(in.board, HIT, hitR, hitC);
+            for (int r = 0; r < RulesT::ROWS; ++r) blockRows[r] |= sunkRows[r];
+            for (int c = 0; c < RulesT::COLS; ++c) blockCols[c] |= sunkCols[c];
+        }
+        for (int r = 0; r < RulesT::ROWS; ++r) {
+            s.availRows[l][r] = static_cast<Mask>(~(blockRows[r] | hitR[r]));
+            s.hitRows[r + 2][l] = static_cast<int64_t>(hitR[r]) << 2;
+            s.blockRows[r][l] = blockRows[r];
+            s.hitMaskRows[r][l] = hitR[r];
+        }
+        s.hitRows[0][l] = s.hitRows[1][l] = s.hitRows[RulesT::ROWS + 2][l] = s.hitRows[RulesT::ROWS + 3][l] = 0;
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            s.blockCols[c][l] = blockCols[c];
+            s.hitMaskCols[c][l] = hitC[c];
+        }
+
+        int activeShips = 0, minShipSize = INT_MAX;
+        bool bigShipLeft = false;
+        Mask rowFit[RulesT::ROWS], colFit[RulesT::COLS];
+        for (int len = 0; len <= MAX_LEN; ++len) s.shipsOfLen[len][l] = 0;
+        for (int i = 0; i <= RulesT::SHIPS; ++i) {
+            int len = i < RulesT::SHIPS ? in.remaining[i] : (minShipSize == INT_MAX ? 0 : minShipSize);
+            if (i < RulesT::SHIPS) {
+                s.shipW[i][l] = len == 0 ? 0.0 : 1.0 + 0.2 * len;
+                if (len > 0 && len <= MAX_LEN) s.shipsOfLen[len][l]++;
+                if (len != 0) {
+                    activeShips++;
+                    if (len > 0 && len < minShipSize) minShipSize = len;
+                    if (len >= 3) bigShipLeft = true;
+                }
+            }
+            fitStarts(blockRows, RulesT::ROWS, RulesT::COLS, len, rowFit);
+            fitStarts(blockCols, RulesT::COLS, RulesT::ROWS, len, colFit);
+            for (int r = 0; r < RulesT::ROWS; ++r) s.fitRows[i][r][l] = rowFit[r];
+            for (int c = 0; c < RulesT::COLS; ++c) s.fitCols[i][c][l] = colFit[c];
+        }
+
+        s.fitDiv[l] = activeShips > 0 ? activeShips : 1;     // x / 1.0 == x
+        s.alpha[l] = (in.turn < 10) ? W.globalAlphaEarly : W.globalAlphaLate;
+        s.beta[l] = 1.0 - s.alpha[l];
+        s.decay[l] = exp(-W.liveDecayFactor * in.turn);
+        s.parity[0][l] = bigShipLeft ? W.parityBonus : 0.0;
+        s.parity[1][l] = bigShipLeft ? W.parityPenalty : 0.0;
+    }
+
+    // Stage 1's placement counts for every lane together
+    placementCountsLanes(s, padded, W.placementHitMultiplier);
+
+    // The rest of refineMoveMap lane by lane: the placement blend (counts of cells
+    // that are not unknown are zero, as in placementCounts), then endgame Monte Carlo
+    for (int l = 0; l < count; ++l) {
+        const BasicMoveLane<RulesT> &in = lanes[l];
+        char view[RulesT::ROWS][RulesT::COLS];
+        shooterView<RulesT>(in.board, view);
+        int counts[RulesT::ROWS][RulesT::COLS];
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
+                counts[r][c] = (s.availRows[l][r] >> c) & 1 ? s.counts[r * RulesT::COLS + c][l] : 0;
+        double placement[RulesT::ROWS][RulesT::COLS];
+        placementMapFromCounts<RulesT>(view, counts, placement);
+        blendPlacementMap<RulesT>(placement, in.liveProb);
+        int iterations = endgameMcIterations<RulesT>(in.remaining);
+        if (iterations > 0) blendMonteCarlo<RulesT>(view, in.remaining, iterations, in.liveProb);
+
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c) {
+                s.global[r * RulesT::COLS + c][l] = in.globalProb[r][c];
+                s.live[r * RulesT::COLS + c][l] = in.liveProb[r][c];
+                s.adjHits[l][r * RulesT::COLS + c] = static_cast<uint8_t>(
+                    ((s.hitRows[r + 1][l] >> (c + 2)) & 1) + ((s.hitRows[r + 3][l] >> (c + 2)) & 1) +
+                    ((s.hitRows[r + 2][l] >> (c + 1)) & 1) + ((s.hitRows[r + 2][l] >> (c + 3)) & 1));
+            }
+    }
+
+    // The terms of scoreCell in the same order, LANE_WIDTH lanes at a time. A term
+    // that does not apply adds +0.0, so every lane's sum is bit-identical to the
+    // scalar one. Cells with more than two adjacent hits (rare) take scoreCell itself.
+    const LaneI one = {1, 1}, zero = {0, 0};
+    const LaneD three = splat(3.0), noFit = splat(W.noFitPenalty), tactical = splat(W.tacticalLiveBonus);
+    const LaneD adjBonus = splat(W.adjHitBonus), lineBonus = splat(W.adjLineBonus);
+    const LaneD diagBonus = splat(W.diagHitBonus), adjAll = splat(W.adjHitBonus + 0.2);
+    const LaneD fitBase = splat(W.fitScoreBaseFactor), zeroD = splat(0.0);
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            const int cell = r * RulesT::COLS + c;
+            const int at = c + 2;
+            for (int l = 0; l < padded; l += LANE_WIDTH) {
+                LaneD fit = zeroD;
+                for (int i = 0; i < RulesT::SHIPS; ++i) {
+                    LaneD w = loadLanes(&s.shipW[i][l]);
+                    fit += keep(w, -((loadLanes(&s.fitCols[i][c][l]) >> r) & one));
+                    fit += keep(w, -((loadLanes(&s.fitRows[i][r][l]) >> c) & one));
+                }
+                fit /= loadLanes(&s.fitDiv[l]);
+                LaneI over = fit > three;
+                fit = (LaneD)(((LaneI)three & over) | ((LaneI)fit & ~over));
+
+                LaneI up2 = loadLanes(&s.hitRows[r][l]), up = loadLanes(&s.hitRows[r + 1][l]);
+                LaneI row = loadLanes(&s.hitRows[r + 2][l]);
+                LaneI down = loadLanes(&s.hitRows[r + 3][l]), down2 = loadLanes(&s.hitRows[r + 4][l]);
+                LaneI hu = (up >> at) & one, hd = (down >> at) & one;
+                LaneI hl = (row >> (at - 1)) & one, hr = (row >> (at + 1)) & one;
+                LaneI canFit = ((loadLanes(&s.fitCols[RulesT::SHIPS][c][l]) >> r) |
+                                (loadLanes(&s.fitRows[RulesT::SHIPS][r][l]) >> c)) & one;
+                LaneD lv = loadLanes(&s.live[cell][l]);
+
+                LaneD sum = zeroD;
+                sum += keep(noFit, canFit == zero);
+                sum += loadLanes(&s.alpha[l]) * loadLanes(&s.global[cell][l]);
+                sum += loadLanes(&s.beta[l]) * lv * loadLanes(&s.decay[l]);
+                sum += keep(tactical, lv > zeroD);
+                sum += loadLanes(&s.parity[(r + c) % 2][l]);
+                sum += keep(adjBonus, -hu);
+                sum += keep(lineBonus, -(hu & (up2 >> at)));
+                sum += keep(adjBonus, -hd);
+                sum += keep(lineBonus, -(hd & (down2 >> at)));
+                sum += keep(adjBonus, -hl);
+                sum += keep(lineBonus, -(hl & (row >> (at - 2))));
+                sum += keep(adjBonus, -hr);
+                sum += keep(lineBonus, -(hr & (row >> (at + 2))));
+                sum += keep(diagBonus, -((up >> (at - 1)) & one));
+                sum += keep(diagBonus, -((up >> (at + 1)) & one));
+                sum += keep(diagBonus, -((down >> (at - 1)) & one));
+                sum += keep(diagBonus, -((down >> (at + 1)) & one));
+                sum += __builtin_convertvector(hu + hd + hl + hr, LaneD) * adjAll;
+                sum += fitBase * fit;
+                std::memcpy(&s.score[cell][l], &sum, sizeof(sum));
+            }
+        }
+    }
+
+    for (int l = 0; l < count; ++l) {
+        const BasicMoveLane<RulesT> &in = lanes[l];
+        moves[l] = pickMove<RulesT>(in.board, *in.ts, [&](int r, int c) {
+            int cell = r * RulesT::COLS + c;
+            if (!((s.availRows[l][r] >> c) & 1)) return -1.0;
+            if (s.adjHits[l][cell] > 2)
+                return scoreCell<RulesT>(r, c, in.board, in.globalProb, in.liveProb, in.remaining, in.turn);
+            return s.score[cell][l];
+        });
+    }
+}
+
 // Hybrid scoring: blend heatmap, parity, and adjacency bonuses
+template <class RulesT>
 double scoreCell(int r, int c,
-                 const char board[NUM_ROWS][NUM_COLS],
-                 double globalProb[NUM_ROWS][NUM_COLS],
-                 double liveProb[NUM_ROWS][NUM_COLS],
-                 const int remaining[NUM_SHIPS],
+                 const char board[RulesT::ROWS][RulesT::COLS],
+                 double globalProb[RulesT::ROWS][RulesT::COLS],
+                 double liveProb[RulesT::ROWS][RulesT::COLS],
+                 const int remaining[RulesT::SHIPS],
                  int turn) {
+    ProfileScope profile(PROFILE_SCORE_CELL);
     
     
     double score = 0.0;
+    const AIWeights &W = aiWeights();
 
-    if (!checkShotIsAvailable(board, r, c)) return -1.0;
+    if (!checkShotIsAvailable<RulesT>(board, r, c)) return -1.0;
 
-    double fitScore = shipFitBiasScoreAt(board, r, c, remaining);
+    double fitScore = shipFitBiasScoreAt<RulesT>(board, r, c, remaining);
 
     // Only apply fit bias if heatmap is promising
     // if (globalProb[r][c] + liveProb[r][c] > 0.2) {
@@ -311,33 +862,33 @@ double scoreCell(int r, int c,
     
         // Ship-length-aware pruning
     int minShipSize = INT_MAX;
-    for (int i = 0; i < NUM_SHIPS; ++i)
+    for (int i = 0; i < RulesT::SHIPS; ++i)
         if (remaining[i] > 0 && remaining[i] < minShipSize)
             minShipSize = remaining[i];
 
     bool canFit = false;
     for (int horiz = 0; horiz <= 1 && !canFit; ++horiz)
-        canFit = shipFitsAt(board, r, c, minShipSize, horiz);
-    if (!canFit) score += gAIWeights.noFitPenalty; // Penalize cells that can't fit smallest ship
+        canFit = shipFitsAt<RulesT>(board, r, c, minShipSize, horiz);
+    if (!canFit) score += W.noFitPenalty; // Penalize cells that can't fit smallest ship
 
     
     // Dynamic heatmap weighting with smoother decay and stronger tactical bias
-    double alpha = (turn < 10) ? gAIWeights.globalAlphaEarly : gAIWeights.globalAlphaLate; // Global
+    double alpha = (turn < 10) ? W.globalAlphaEarly : W.globalAlphaLate; // Global
     double beta = 1.0 - alpha; // Live
-    double decay = exp(-gAIWeights.liveDecayFactor * turn);  // smoother fade over time
+    double decay = exp(-W.liveDecayFactor * turn);  // smoother fade over time
 
     score += alpha * globalProb[r][c];
     score += beta * liveProb[r][c] * decay;
 
     // Tactical streak bonus
-    if (liveProb[r][c] > 0.0) score += gAIWeights.tacticalLiveBonus;
+    if (liveProb[r][c] > 0.0) score += W.tacticalLiveBonus;
 
 
     bool bigShipLeft = false;
-    for (int i = 0; i < NUM_SHIPS; ++i) if (remaining[i] >= 3) { bigShipLeft = true; break; }
+    for (int i = 0; i < RulesT::SHIPS; ++i) if (remaining[i] >= 3) { bigShipLeft = true; break; }
     if (bigShipLeft) {
-        if ((r + c) % 2 == 0) score += gAIWeights.parityBonus;
-        else score += gAIWeights.parityPenalty; }
+        if ((r + c) % 2 == 0) score += W.parityBonus;
+        else score += W.parityPenalty; }
 
 
 // Cardinal Adjacency Loop
@@ -346,15 +897,15 @@ double scoreCell(int r, int c,
     int adjHits = 0;
     for (int k = 0; k < 4; ++k) {
         int nr = r + dr[k], nc = c + dc[k];
-        if (nr >= 0 && nr < NUM_ROWS && nc >= 0 && nc < NUM_COLS) {
+        if (nr >= 0 && nr < RulesT::ROWS && nc >= 0 && nc < RulesT::COLS) {
             if (board[nr][nc] == 'X') {
                 adjHits++;
-                score += gAIWeights.adjHitBonus;
+                score += W.adjHitBonus;
 
                 // Bonus for extending in same direction
                 int nnr = nr + dr[k], nnc = nc + dc[k];
-                if (nnr >= 0 && nnr < NUM_ROWS && nnc >= 0 && nnc < NUM_COLS) {
-                    if (board[nnr][nnc] == 'X') score += gAIWeights.adjLineBonus;
+                if (nnr >= 0 && nnr < RulesT::ROWS && nnc >= 0 && nnc < RulesT::COLS) {
+                    if (board[nnr][nnc] == 'X') score += W.adjLineBonus;
                 }
             }
         }
@@ -364,20 +915,20 @@ double scoreCell(int r, int c,
 const int dc_diag[4] = {-1, 1, -1, 1};
 for (int k = 0; k < 4; ++k) {
     int nr = r + dr_diag[k], nc = c + dc_diag[k];
-    if (nr >= 0 && nr < NUM_ROWS && nc >= 0 && nc < NUM_COLS) {
-        if (board[nr][nc] == 'X') score += gAIWeights.diagHitBonus;
+    if (nr >= 0 && nr < RulesT::ROWS && nc >= 0 && nc < RulesT::COLS) {
+        if (board[nr][nc] == 'X') score += W.diagHitBonus;
     }
 }
 
 
 
     if (adjHits > 2) {
-        double fitScore = shipFitBiasScoreAt(board, r, c, remaining);
-        score += gAIWeights.fitScoreNearAdjFactor * fitScore;  // Only boost fit if near a hit
+        double fitScore = shipFitBiasScoreAt<RulesT>(board, r, c, remaining);
+        score += W.fitScoreNearAdjFactor * fitScore;  // Only boost fit if near a hit
     }
 
-    score += adjHits * (gAIWeights.adjHitBonus + 0.2); // slight compounded effect
-    score += gAIWeights.fitScoreBaseFactor * fitScore; // base fit influence
+    score += adjHits * (W.adjHitBonus + 0.2); // slight compounded effect
+    score += W.fitScoreBaseFactor * fitScore; // base fit influence
     
     // Debug output
     // printf("Turn %d | Global: %.3f | Live: %.3f | Decay: %.3f | Weighted Live: %.3f\n",
@@ -387,16 +938,58 @@ for (int k = 0; k < 4; ++k) {
     return score;
 }
 
-bool shipFitsAt(const char board[NUM_ROWS][NUM_COLS], int r, int c, int size, bool horiz) {
+template <class RulesT>
+bool scoreCellTerms(int r, int c,
+                    const char board[RulesT::ROWS][RulesT::COLS],
+                    double globalProb[RulesT::ROWS][RulesT::COLS],
+                    double liveProb[RulesT::ROWS][RulesT::COLS],
+                    const int remaining[RulesT::SHIPS],
+                    int turn,
+                    ScoreTerms &out) {
+    if (!checkShotIsAvailable<RulesT>(board, r, c)) return false;
+    const AIWeights &W = aiWeights();
+    out.global = globalProb[r][c];
+    out.live = liveProb[r][c];
+    out.decay = exp(-W.liveDecayFactor * turn);
+
+    int minShipSize = INT_MAX;
+    bool bigShipLeft = false;
+    for (int i = 0; i < RulesT::SHIPS; ++i) {
+        if (remaining[i] > 0 && remaining[i] < minShipSize) minShipSize = remaining[i];
+        if (remaining[i] >= 3) bigShipLeft = true;
+    }
+    out.canFit = shipFitsAt<RulesT>(board, r, c, minShipSize, false) || shipFitsAt<RulesT>(board, r, c, minShipSize, true);
+    out.parity = bigShipLeft ? ((r + c) % 2 == 0 ? 1 : -1) : 0;
+
+    auto isHit = [&](int nr, int nc) {
+        return nr >= 0 && nr < RulesT::ROWS && nc >= 0 && nc < RulesT::COLS && board[nr][nc] == 'X';
+    };
+    const int dr[4] = {-1, 1, 0, 0}, dc[4] = {0, 0, -1, 1};
+    out.adjHits = out.adjLines = out.diagHits = 0;
+    for (int k = 0; k < 4; ++k) {
+        if (!isHit(r + dr[k], c + dc[k])) continue;
+        out.adjHits++;
+        if (isHit(r + 2 * dr[k], c + 2 * dc[k])) out.adjLines++;
+    }
+    for (int k = 0; k < 4; ++k)
+        if (isHit(r + (k < 2 ? -1 : 1), c + (k % 2 ? 1 : -1))) out.diagHits++;
+
+    out.fitBias = shipFitBiasScoreAt<RulesT>(board, r, c, remaining);
+    out.score = scoreCell<RulesT>(r, c, board, globalProb, liveProb, remaining, turn);
+    return true;
+}
+
+template <class RulesT>
+bool shipFitsAt(const char board[RulesT::ROWS][RulesT::COLS], int r, int c, int size, bool horiz) {
     if (horiz) {
-        if (c + size > NUM_COLS) return false;
+        if (c + size > RulesT::COLS) return false;
         for (int k = 0; k < size; ++k) {
             char cell = board[r][c + k];
             if (cell != '-' && !isShipSymbol(cell) && cell != 'X') return false;
         }
         return true;
     } else {
-        if (r + size > NUM_ROWS) return false;
+        if (r + size > RulesT::ROWS) return false;
         for (int k = 0; k < size; ++k) {
             char cell = board[r + k][c];
             if (cell != '-' && !isShipSymbol(cell) && cell != 'X') return false;
@@ -405,32 +998,34 @@ bool shipFitsAt(const char board[NUM_ROWS][NUM_COLS], int r, int c, int size, bo
     }
 }
 
-int shipFitScoreAt(const char board[NUM_ROWS][NUM_COLS],
+template <class RulesT>
+int shipFitScoreAt(const char board[RulesT::ROWS][RulesT::COLS],
                    int r, int c,
-                   const int remaining[NUM_SHIPS]) {
+                   const int remaining[RulesT::SHIPS]) {
     int score = 0;
-    for (int i = 0; i < NUM_SHIPS; ++i) {
+    for (int i = 0; i < RulesT::SHIPS; ++i) {
         int size = remaining[i];
         if (size <= 0) continue;
         for (int startC = c - size + 1; startC <= c; ++startC) {
-            if (startC < 0 || startC + size > NUM_COLS) continue;
-            if (shipFitsAt(board, r, startC, size, true)) score++;
+            if (startC < 0 || startC + size > RulesT::COLS) continue;
+            if (shipFitsAt<RulesT>(board, r, startC, size, true)) score++;
         }
         for (int startR = r - size + 1; startR <= r; ++startR) {
-            if (startR < 0 || startR + size > NUM_ROWS) continue;
-            if (shipFitsAt(board, startR, c, size, false)) score++;
+            if (startR < 0 || startR + size > RulesT::ROWS) continue;
+            if (shipFitsAt<RulesT>(board, startR, c, size, false)) score++;
         }
     }
     return score;
 }
 
-double shipFitBiasScoreAt(const char board[NUM_ROWS][NUM_COLS],
+template <class RulesT>
+double shipFitBiasScoreAt(const char board[RulesT::ROWS][RulesT::COLS],
                           int r, int c,
-                          const int remaining[NUM_SHIPS]) {
+                          const int remaining[RulesT::SHIPS]) {
     double score = 0.0;
     int activeShips = 0;
 
-    for (int i = 0; i < NUM_SHIPS; ++i) {
+    for (int i = 0; i < RulesT::SHIPS; ++i) {
         if (remaining[i] == 0) continue;
         activeShips++;
 
@@ -438,7 +1033,7 @@ double shipFitBiasScoreAt(const char board[NUM_ROWS][NUM_COLS],
         double weight = 1.0 + 0.2 * len;  // gentle bias toward longer ships
 
         for (int horiz = 0; horiz <= 1; ++horiz) {
-            if (shipFitsAt(board, r, c, len, horiz)) {
+            if (shipFitsAt<RulesT>(board, r, c, len, horiz)) {
                 score += weight;
             }
         }
@@ -457,27 +1052,104 @@ double shipFitBiasScoreAt(const char board[NUM_ROWS][NUM_COLS],
 
 
 
+// Cells of the segment `bit` (see SunkShips::Sink) through `cell`; false when it leaves the board
+template <class RulesT>
+static bool sinkSegment(int cell, int length, int bit, BasicBitboard<RulesT::CELLS> &out) {
+    bool vertical = bit >= 16;
+    int offset = bit & 15;
+    int r = cell / RulesT::COLS - (vertical ? offset : 0);
+    int c = cell % RulesT::COLS - (vertical ? 0 : offset);
+    if (r < 0 || c < 0 || (vertical ? r + length > RulesT::ROWS : c + length > RulesT::COLS)) return false;
+    out.clear();
+    for (int k = 0; k < length; ++k)
+        out.set((r + (vertical ? k : 0)) * RulesT::COLS + c + (vertical ? 0 : k));
+    return true;
+}
+
+// Cells common to every remaining segment of a sink
+template <class RulesT>
+static BasicBitboard<RulesT::CELLS> sinkCore(const typename BasicSunkShips<RulesT>::Sink &s) {
+    BasicBitboard<RulesT::CELLS> core, seg;
+    for (uint64_t &w : core.w) w = ~0ULL;
+    for (int bit = 0; bit < 32; ++bit) {
+        if (!((s.candidates >> bit) & 1) || !sinkSegment<RulesT>(s.cell, s.length, bit, seg)) continue;
+        core &= seg;
+    }
+    if (!s.candidates) core.clear();
+    return core;
+}
+
+template <class RulesT>
+void BasicSunkShips<RulesT>::add(const Cells &hits, int row, int col, int length) {
+    if (count >= RulesT::SHIPS || length <= 0) return;
+    Sink s{static_cast<uint8_t>(row * RulesT::COLS + col), static_cast<uint8_t>(length), 0};
+    Cells seg;
+    for (int vertical = 0; vertical <= 1; ++vertical)
+        for (int offset = 0; offset < length; ++offset) {
+            int bit = vertical * 16 + offset;
+            if (!sinkSegment<RulesT>(s.cell, length, bit, seg)) continue;
+            if (!seg.coveredBy(hits)) continue;
+            s.candidates |= 1u << bit;
+        }
+    sinks[count++] = s;
+
+    // Another sink's core is certainly that ship's, so no other segment may use it
+    Cells core[RulesT::SHIPS];
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < count; ++i) core[i] = sinkCore<RulesT>(sinks[i]);
+        for (int i = 0; i < count; ++i) {
+            Cells taken;
+            for (int j = 0; j < count; ++j)
+                if (j != i) taken |= core[j];
+            for (int bit = 0; bit < 32; ++bit) {
+                uint32_t mask = 1u << bit;
+                // Keep the last segment even if the observations are inconsistent
+                if (!(sinks[i].candidates & mask) || sinks[i].candidates == mask) continue;
+                sinkSegment<RulesT>(sinks[i].cell, sinks[i].length, bit, seg);
+                if (seg.intersects(taken)) {
+                    sinks[i].candidates &= ~mask;
+                    changed = true;
+                }
+            }
+        }
+    }
+    cells.clear();
+    for (int i = 0; i < count; ++i) cells |= sinkCore<RulesT>(sinks[i]);
+}
+
+template <class RulesT>
+void BasicSunkShips<RulesT>::overlay(char board[RulesT::ROWS][RulesT::COLS]) const {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            if (cells.test(r * RulesT::COLS + c)) board[r][c] = SUNK;
+}
+
 // Count consecutive hits in a given orientation (horizontal or vertical)
-int countConsecutiveHits(const char board[NUM_ROWS][NUM_COLS],
+template <class RulesT>
+int countConsecutiveHits(const char board[RulesT::ROWS][RulesT::COLS],
                          int row, int col, int orientation) {
     int count = 1;
     if (orientation == 1) { // horizontal
         for (int c = col - 1; c >= 0 && board[row][c] == 'X'; --c) count++;
-        for (int c = col + 1; c < NUM_COLS && board[row][c] == 'X'; ++c) count++;
+        for (int c = col + 1; c < RulesT::COLS && board[row][c] == 'X'; ++c) count++;
     } else if (orientation == 2) { // vertical
         for (int r = row - 1; r >= 0 && board[r][col] == 'X'; --r) count++;
-        for (int r = row + 1; r < NUM_ROWS && board[r][col] == 'X'; ++r) count++;
+        for (int r = row + 1; r < RulesT::ROWS && board[r][col] == 'X'; ++r) count++;
     }
     return count;
 }
 
 // Update target state after applying a shot result
-void updateTargetStateAfterResult(TargetState &ts,
-                                  const char targetBoard[NUM_ROWS][NUM_COLS],
+template <class RulesT>
+void updateTargetStateAfterResult(BasicTargetState<RulesT> &ts,
+                                  const char targetBoard[RulesT::ROWS][RulesT::COLS],
                                   int shotRow, int shotCol,
                                   int resultShipIndex,
                                   bool sunk,
-                                  int targetShipSizes[NUM_SHIPS]) {
+                                  int targetShipSizes[RulesT::SHIPS]) {
+    ProfileScope profile(PROFILE_TARGET_UPDATE);
     if (resultShipIndex != -1) { // HIT
         if (!ts.active) {
             ts.active = true;
@@ -486,7 +1158,7 @@ void updateTargetStateAfterResult(TargetState &ts,
             ts.oriented = false;
             ts.orientation = 0;
             ts.queue.clear();
-            enqueueNeighbors(ts, targetBoard, shotRow, shotCol);
+            enqueueNeighbors<RulesT>(ts, targetBoard, shotRow, shotCol);
         } else {
             // Determine orientation if not set
             if (!ts.oriented) {
@@ -501,19 +1173,19 @@ void updateTargetStateAfterResult(TargetState &ts,
 
             if (ts.oriented) {
                 // Extend along the line and reverse if blocked
-                enqueueOrientedLine(ts, targetBoard);
+                enqueueOrientedLine<RulesT>(ts, targetBoard);
 
                 // Ship-length awareness (optional thresholding)
-                int streak = countConsecutiveHits(targetBoard, shotRow, shotCol, ts.orientation);
+                int streak = countConsecutiveHits<RulesT>(targetBoard, shotRow, shotCol, ts.orientation);
                 int minRemaining = INT_MAX;
-                for (int i = 0; i < NUM_SHIPS; ++i) {
+                for (int i = 0; i < RulesT::SHIPS; ++i) {
                     if (targetShipSizes[i] > 0 && targetShipSizes[i] < minRemaining)
                         minRemaining = targetShipSizes[i];
                 }
                 // We always keep extending; minRemaining can guide future pruning if you want
             } else {
                 ts.queue.clear();
-                enqueueNeighbors(ts, targetBoard, shotRow, shotCol);
+                enqueueNeighbors<RulesT>(ts, targetBoard, shotRow, shotCol);
             }
         }
 
@@ -528,7 +1200,7 @@ void updateTargetStateAfterResult(TargetState &ts,
         if (ts.active && ts.oriented) {
             // Reverse direction: rebuild line queue from last known hit
             ts.queue.clear();
-            enqueueOrientedLine(ts, targetBoard);
+            enqueueOrientedLine<RulesT>(ts, targetBoard);
         } else if (ts.active && ts.queue.empty()) {
             ts.active = false;
             ts.oriented = false;
@@ -538,12 +1210,13 @@ void updateTargetStateAfterResult(TargetState &ts,
 }
 
 // Generate a weight for each cell: higher in the center, lower at edges
-void generatePlacementWeights(double weights[NUM_ROWS][NUM_COLS]) {
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+template <class RulesT>
+void generatePlacementWeights(double weights[RulesT::ROWS][RulesT::COLS]) {
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             // Distance from edge (favor center)
-            int dr = min(r, NUM_ROWS - 1 - r);
-            int dc = min(c, NUM_COLS - 1 - c);
+            int dr = min(r, RulesT::ROWS - 1 - r);
+            int dc = min(c, RulesT::COLS - 1 - c);
             int edgeDist = min(dr, dc);
             weights[r][c] = 1.0 + edgeDist * 0.5;
         }
@@ -551,176 +1224,161 @@ void generatePlacementWeights(double weights[NUM_ROWS][NUM_COLS]) {
 }
 
 
-// Enumerate placements for each remaining ship and count how many placements
-// cover each unknown cell. Produces a normalized probability map in outProb.
-void computePlacementProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
-                                   const int remaining[NUM_SHIPS],
-                                   double outProb[NUM_ROWS][NUM_COLS]) {
-    // zero counts
-    int counts[NUM_ROWS][NUM_COLS] = {0};
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+// Normalizes placement counts to a map with maximum 1 (every unknown cell at 1 when
+// nothing fits)
+template <class RulesT>
+static void placementMapFromCounts(const char boardView[RulesT::ROWS][RulesT::COLS], const int counts[RulesT::ROWS][RulesT::COLS],
+                                   double outProb[RulesT::ROWS][RulesT::COLS]) {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             outProb[r][c] = 0.0;
 
-    // For each ship size remaining, enumerate placements
-    for (int i = 0; i < NUM_SHIPS; ++i) {
-        int len = remaining[i];
-        if (len <= 0) continue;
-
-        for (int horiz = 0; horiz <= 1; ++horiz) {
-            int dr = horiz ? 0 : 1;
-            int dc = horiz ? 1 : 0;
-
-            for (int r = 0; r < NUM_ROWS; ++r) {
-                for (int c = 0; c < NUM_COLS; ++c) {
-                    int endR = r + dr * (len - 1);
-                    int endC = c + dc * (len - 1);
-                    if (endR < 0 || endR >= NUM_ROWS || endC < 0 || endC >= NUM_COLS) continue;
-
-                    bool valid = true;
-                    for (int k = 0; k < len; ++k) {
-                        int nr = r + k * dr;
-                        int nc = c + k * dc;
-                        char cell = boardView[nr][nc];
-                        if (cell == 'm') { valid = false; break; } // placement hits a known miss
-                        // 'X' (known hit) is allowed and desirable
-                    }
-                    if (!valid) continue;
-
-                    // Determine placement weight: placements that cover existing hits are more valuable
-                    int coversHit = 0;
-                    for (int k = 0; k < len; ++k) {
-                        int nr = r + k * dr;
-                        int nc = c + k * dc;
-                        if (boardView[nr][nc] == 'X') coversHit++;
-                    }
-                    double placementWeight = 1.0 + gAIWeights.placementHitMultiplier * coversHit; // increase weight if it includes hits
-
-                    // This placement is valid; increment counts for unknown cells
-                    for (int k = 0; k < len; ++k) {
-                        int nr = r + k * dr;
-                        int nc = c + k * dc;
-                        if (boardView[nr][nc] == '-') counts[nr][nc] += static_cast<int>(placementWeight);
-                    }
-                }
-            }
-        }
-    }
-
     // Find max count for normalization
     int maxCount = 0;
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             if (counts[r][c] > maxCount) maxCount = counts[r][c];
 
     if (maxCount == 0) {
         // fallback: small uniform map for any available shots
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
                 outProb[r][c] = (boardView[r][c] == '-') ? 1.0 : 0.0;
         // normalize
         double localMax = 0.0;
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
                 if (outProb[r][c] > localMax) localMax = outProb[r][c];
-        if (localMax > 0.0) for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c) outProb[r][c] /= localMax;
+        if (localMax > 0.0) for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c) outProb[r][c] /= localMax;
         return;
     }
 
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             outProb[r][c] = static_cast<double>(counts[r][c]) / static_cast<double>(maxCount);
 }
 
+// Enumerate placements for each remaining ship and count how many placements
+// cover each unknown cell. Produces a normalized probability map in outProb.
+template <class RulesT>
+void computePlacementProbabilities(const char boardView[RulesT::ROWS][RulesT::COLS],
+                                   const int remaining[RulesT::SHIPS],
+                                   double outProb[RulesT::ROWS][RulesT::COLS]) {
+    ProfileScope profile(PROFILE_PLACEMENT);
+    int counts[RulesT::ROWS][RulesT::COLS] = {0};
+    // Misses and resolved sunk cells block a placement, hits ('X') raise its weight
+    // (see placementCounts)
+    placementCounts<RulesT>(boardView, remaining, aiWeights().placementHitMultiplier, counts);
+    placementMapFromCounts<RulesT>(boardView, counts, outProb);
+}
+
+
+// Adds the cells covered by `iterations` random consistent fleets to counts.
+// Samples where a ship cannot be placed within 200 attempts are dropped.
+template <class RulesT>
+static void sampleMonteCarloCounts(const char boardView[RulesT::ROWS][RulesT::COLS],
+                                   const int ships[], int nShips, int iterations,
+                                   int counts[RulesT::ROWS][RulesT::COLS]) {
+    monteCarloCounts<RulesT>(boardView, ships, nShips, iterations, gameRng(), counts);
+}
+
+// One chunk of a split Monte Carlo run
+template <class RulesT>
+struct McChunkJob {
+    const char (*view)[RulesT::COLS];
+    const int *ships;
+    int nShips, iterations;
+    const uint64_t *seeds;
+    int (*partial)[RulesT::ROWS][RulesT::COLS];
+};
+
+template <class RulesT>
+static void sampleMonteCarloChunk(const McChunkJob<RulesT> &job, int k) {
+    GameRng rng;
+    rng.seed(job.seeds[k]);
+    GameRngScope scope(rng);
+    int n = job.iterations / MC_CHUNKS + (k < job.iterations % MC_CHUNKS ? 1 : 0);
+    sampleMonteCarloCounts<RulesT>(job.view, job.ships, job.nShips, n, job.partial[k]);
+}
+
+// The CUDA sampler's counts, when a device is available. The kernel is built for
+// the standard board, so other rule sets always sample on the CPU.
+template <class RulesT>
+static bool monteCarloCountsGPU(const char boardView[RulesT::ROWS][RulesT::COLS], const int remaining[RulesT::SHIPS],
+                                int iterations, int counts[RulesT::ROWS][RulesT::COLS]) {
+#ifndef __EMSCRIPTEN__
+    if constexpr (std::is_same<RulesT, StandardRules>::value) {
+        if (!cudaAvailable()) return false;
+        int flatCounts[RulesT::CELLS];
+        for (int i = 0; i < RulesT::CELLS; ++i) flatCounts[i] = 0;
+        monteCarloProbabilitiesGPU(boardView, remaining, iterations, flatCounts);
+        for (int r = 0; r < RulesT::ROWS; ++r) for (int c = 0; c < RulesT::COLS; ++c) counts[r][c] = flatCounts[r*RulesT::COLS + c];
+        return true;
+    }
+#endif
+    return false;
+}
 
 // Monte-Carlo sampler: randomly place remaining ships consistent with boardView.
 // iterations controls sample count. This is slower but often produces robust maps.
-void monteCarloProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
-                             const int remaining[NUM_SHIPS],
+template <class RulesT>
+void monteCarloProbabilities(const char boardView[RulesT::ROWS][RulesT::COLS],
+                             const int remaining[RulesT::SHIPS],
                              int iterations,
-                             double outProb[NUM_ROWS][NUM_COLS]) {
+                             double outProb[RulesT::ROWS][RulesT::COLS]) {
+    ProfileScope profile(PROFILE_MONTE_CARLO);
+    EngineMetrics *metrics = engineMetrics();
+    HistogramTimer timeMc(metrics ? &metrics->mcTimeNs : nullptr);
     // accumulate counts
-    int counts[NUM_ROWS][NUM_COLS] = {0};
-    srand(static_cast<unsigned int>(time(nullptr)));
+    int counts[RulesT::ROWS][RulesT::COLS] = {0};
 
-#ifndef __EMSCRIPTEN__
-    // If CUDA is available at runtime, prefer GPU path (mc_cuda provides cudaAvailable())
-    extern int cudaAvailable();
-    extern void monteCarloProbabilitiesGPU(const char boardView[NUM_ROWS][NUM_COLS], const int remaining[NUM_SHIPS], int iterations, int outCounts[NUM_ROWS * NUM_COLS]);
-    if (cudaAvailable()) {
-        int flatCounts[NUM_ROWS * NUM_COLS];
-        for (int i = 0; i < NUM_ROWS * NUM_COLS; ++i) flatCounts[i] = 0;
-        monteCarloProbabilitiesGPU(boardView, remaining, iterations, flatCounts);
-        for (int r = 0; r < NUM_ROWS; ++r) for (int c = 0; c < NUM_COLS; ++c) counts[r][c] = flatCounts[r*NUM_COLS + c];
+    // If CUDA is available at runtime, prefer GPU path (mc_cuda provides cudaAvailable());
+    // WASM builds have no CUDA and always take the CPU path
+    if (monteCarloCountsGPU<RulesT>(boardView, remaining, iterations, counts)) {
         // fall through to normalization below
     } else {
-#else
-    // WASM build - CUDA not available, use CPU path only
-    {
-#endif
-        // Precompute list of ship sizes to place
-        vector<int> ships;
-        for (int i = 0; i < NUM_SHIPS; ++i) if (remaining[i] > 0) ships.push_back(remaining[i]);
-        if (ships.empty()) {
-            for (int r = 0; r < NUM_ROWS; ++r)
-                for (int c = 0; c < NUM_COLS; ++c) outProb[r][c] = 0.0;
+        int ships[RulesT::SHIPS];
+        int nShips = 0;
+        for (int i = 0; i < RulesT::SHIPS; ++i) if (remaining[i] > 0) ships[nShips++] = remaining[i];
+        if (nShips == 0) {
+            for (int r = 0; r < RulesT::ROWS; ++r)
+                for (int c = 0; c < RulesT::COLS; ++c) outProb[r][c] = 0.0;
             return;
         }
 
-        for (int it = 0; it < iterations; ++it) {
-            // try to place all ships randomly; if fail, skip sample
-            char sample[NUM_ROWS][NUM_COLS];
-            for (int r = 0; r < NUM_ROWS; ++r)
-                for (int c = 0; c < NUM_COLS; ++c) sample[r][c] = boardView[r][c];
-
-            bool ok = true;
-            for (int s = 0; s < (int)ships.size(); ++s) {
-                int len = ships[s];
-                bool placed = false;
-                for (int attempt = 0; attempt < 200 && !placed; ++attempt) {
-                    bool horiz = rand() % 2;
-                    int r = rand() % NUM_ROWS;
-                    int c = rand() % NUM_COLS;
-                    if (!shipFitsAt(sample, r, c, len, horiz)) continue;
-                    // ensure doesn't overwrite known misses or hits in inconsistent way
-                    bool conflict = false;
-                    for (int k = 0; k < len; ++k) {
-                        int nr = r + (horiz ? 0 : k);
-                        int nc = c + (horiz ? k : 0);
-                        if (boardView[nr][nc] == 'm') { conflict = true; break; }
-                    }
-                    if (conflict) continue;
-                    // place with symbol 'S'
-                    for (int k = 0; k < len; ++k) {
-                        int nr = r + (horiz ? 0 : k);
-                        int nc = c + (horiz ? k : 0);
-                        sample[nr][nc] = 'S';
-                    }
-                    placed = true;
-                }
-                if (!placed) { ok = false; break; }
-            }
-            if (!ok) continue;
-
-            // accumulate counts for unknown cells
-            for (int r = 0; r < NUM_ROWS; ++r)
-                for (int c = 0; c < NUM_COLS; ++c)
-                    if (sample[r][c] == 'S') counts[r][c]++;
+        if (iterations >= MC_PARALLEL_MIN_ITERATIONS) {
+            // MC_CHUNKS chunks, each with its own generator seeded from the game's;
+            // the job captures one pointer so std::function stores it inline
+            uint64_t seeds[MC_CHUNKS];
+            for (int k = 0; k < MC_CHUNKS; ++k) seeds[k] = gameRng().next();
+            int partial[MC_CHUNKS][RulesT::ROWS][RulesT::COLS] = {};
+            McChunkJob<RulesT> job = {boardView, ships, nShips, iterations, seeds, partial};
+#ifdef BATTLESHIP_THREADS
+            const McChunkJob<RulesT> *jp = &job;
+            WorkerPool::shared().parallelFor(MC_CHUNKS, [jp](int k) { sampleMonteCarloChunk<RulesT>(*jp, k); });
+#else
+            for (int k = 0; k < MC_CHUNKS; ++k) sampleMonteCarloChunk<RulesT>(job, k);
+#endif
+            for (int k = 0; k < MC_CHUNKS; ++k)
+                for (int r = 0; r < RulesT::ROWS; ++r)
+                    for (int c = 0; c < RulesT::COLS; ++c) counts[r][c] += partial[k][r][c];
+        } else {
+            sampleMonteCarloCounts<RulesT>(boardView, ships, nShips, iterations, counts);
         }
 
         int maxCount = 0;
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
                 if (counts[r][c] > maxCount) maxCount = counts[r][c];
 
         if (maxCount == 0) {
-            for (int r = 0; r < NUM_ROWS; ++r)
-                for (int c = 0; c < NUM_COLS; ++c) outProb[r][c] = 0.0;
+            for (int r = 0; r < RulesT::ROWS; ++r)
+                for (int c = 0; c < RulesT::COLS; ++c) outProb[r][c] = 0.0;
             return;
         }
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c)
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c)
                 outProb[r][c] = static_cast<double>(counts[r][c]) / static_cast<double>(maxCount);
     }
     return;
@@ -728,7 +1386,7 @@ void monteCarloProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
 
 /**
  * Pick a cell from the weighted board randomly.
- * The weights are flattened and accumulated, then a random
+ * The weights are accumulated in row-major order, then a random
  * number is generated between 0 and the total weight.
  * The cell corresponding to the first weight that exceeds
  * the random number is returned.
@@ -738,26 +1396,241 @@ void monteCarloProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
  * @return A pair of integers representing the row and column
  *             of the chosen cell.
  */
-pair<int,int> pickWeightedCell(double weights[NUM_ROWS][NUM_COLS]) {
-    vector<double> flat;
-    vector<pair<int,int>> coords;
-    flat.reserve(NUM_ROWS * NUM_COLS);
-    coords.reserve(NUM_ROWS * NUM_COLS);
+template <class RulesT>
+pair<int,int> pickWeightedCell(double weights[RulesT::ROWS][RulesT::COLS]) {
+    double total = 0.0;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) total += weights[r][c];
+    double rnd = gameRng().unit() * total;
+
+    double running = 0.0;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            running += weights[r][c];
+            if (rnd <= running) return {r, c};
+        }
+    return {RulesT::ROWS - 1, RulesT::COLS - 1}; // fallback
+}
+
+
+// A ship of length len lies through a cell of a line of n cells in at most
+// min(len, n - len + 1) placements, reached at the middle of the line
+static int maxPlacementsThrough(int len) {
+    return min(len, NUM_COLS - len + 1) + min(len, NUM_ROWS - len + 1);
+}
+
+const PolicyScaling &policyScaling() {
+    static const PolicyScaling scaling = [] {
+        PolicyScaling s;
+        int cover = 0, largest = 0;
+        for (int i = 0; i < NUM_SHIPS; ++i) {
+            cover += maxPlacementsThrough(SHIP_SIZES[i]);
+            largest = max(largest, SHIP_SIZES[i]);
+        }
+        s.fleetCells = static_cast<float>(StandardRules::FLEET_CELLS);
+        s.coverMax = static_cast<float>(cover);
+        s.largestCoverMax = static_cast<float>(maxPlacementsThrough(largest));
+        s.edgeMax = static_cast<float>((min(NUM_ROWS, NUM_COLS) - 1) / 2);
+        return s;
+    }();
+    return scaling;
+}
+
+// Distilled policy features. Each afloat ship's legal placements (no miss or sunk
+// cell) are counted over the unknown cells they cover, split by how many hits the
+// placement also covers: hit-free placements describe the search, placements
+// through hits the targeting. Counts are also given relative to the board's
+// maximum, since the best cell is what matters.
+void policyFeatures(const char board[NUM_ROWS][NUM_COLS],
+                    const int remaining[NUM_SHIPS],
+                    float out[POLICY_FEATURES][NUM_ROWS * NUM_COLS]) {
+    const int CELLS = NUM_ROWS * NUM_COLS;
+    float cover[3][CELLS] = {{0}};      // placements through 0, 1, 2+ hits
+    float coverLargest[CELLS] = {0};
+    float coverSmallest[CELLS] = {0};
+    int largest = 0, smallest = INT_MAX, afloatCells = 0;
+    for (int i = 0; i < NUM_SHIPS; ++i)
+        if (remaining[i] > 0) {
+            largest = max(largest, SHIP_SIZES[i]);
+            smallest = min(smallest, SHIP_SIZES[i]);
+            afloatCells += SHIP_SIZES[i];
+        }
+    auto isHit = [&](int r, int c) { return board[r][c] == 'X'; };
+    auto isBlocked = [&](int r, int c) { return board[r][c] == 'm' || board[r][c] == SUNK; };
 
-    for (int r = 0; r < NUM_ROWS; ++r) {
+    int unknown = 0, hits = 0;
+    for (int r = 0; r < NUM_ROWS; ++r)
         for (int c = 0; c < NUM_COLS; ++c) {
-            flat.push_back(weights[r][c]);
-            coords.push_back({r, c});
+            if (isHit(r, c)) hits++;
+            else if (!isBlocked(r, c)) unknown++;
+        }
+
+    // Per line (rows, then columns): prefix counts of blocked cells and hits give each
+    // window's legality and hit count in O(1); covers are added through difference
+    // arrays over the line, one per hit bucket and ship class
+    const int LINE = NUM_ROWS > NUM_COLS ? NUM_ROWS : NUM_COLS;
+    for (int horiz = 1; horiz >= 0; --horiz) {
+        const int lines = horiz ? NUM_ROWS : NUM_COLS, lineLen = horiz ? NUM_COLS : NUM_ROWS;
+        for (int line = 0; line < lines; ++line) {
+            int blockedBefore[LINE + 1], hitsBefore[LINE + 1];
+            blockedBefore[0] = hitsBefore[0] = 0;
+            for (int k = 0; k < lineLen; ++k) {
+                int r = horiz ? line : k, c = horiz ? k : line;
+                blockedBefore[k + 1] = blockedBefore[k] + (isBlocked(r, c) ? 1 : 0);
+                hitsBefore[k + 1] = hitsBefore[k] + (isHit(r, c) ? 1 : 0);
+            }
+            float diff[5][LINE + 1] = {{0}};    // 0/1/2+ hits, largest ship, smallest ship
+            for (int i = 0; i < NUM_SHIPS; ++i) {
+                if (remaining[i] <= 0) continue;
+                const int len = SHIP_SIZES[i];
+                for (int start = 0; start + len <= lineLen; ++start) {
+                    if (blockedBefore[start + len] != blockedBefore[start]) continue;
+                    int h = min(hitsBefore[start + len] - hitsBefore[start], 2);
+                    diff[h][start] += 1.0f;
+                    diff[h][start + len] -= 1.0f;
+                    if (len == largest) { diff[3][start] += 1.0f; diff[3][start + len] -= 1.0f; }
+                    if (len == smallest) { diff[4][start] += 1.0f; diff[4][start + len] -= 1.0f; }
+                }
+            }
+            float run[5] = {0, 0, 0, 0, 0};
+            for (int k = 0; k < lineLen; ++k) {
+                for (int j = 0; j < 5; ++j) run[j] += diff[j][k];
+                int cell = horiz ? line * NUM_COLS + k : k * NUM_COLS + line;
+                cover[0][cell] += run[0];
+                cover[1][cell] += run[1];
+                cover[2][cell] += run[2];
+                coverLargest[cell] += run[3];
+                coverSmallest[cell] += run[4];
+            }
         }
     }
 
-    double total = accumulate(flat.begin(), flat.end(), 0.0);
-    double rnd = ((double) rand() / RAND_MAX) * total;
+    // Hit cells are covered too; only unknown cells count
+    float peak[3] = {0, 0, 0};
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (isHit(cell / NUM_COLS, cell % NUM_COLS)) continue;
+        for (int k = 0; k < 3; ++k) peak[k] = max(peak[k], cover[k][cell]);
+    }
+    float inv[3];
+    for (int k = 0; k < 3; ++k) inv[k] = peak[k] > 0 ? 1.0f / peak[k] : 0.0f;
+
+    // Hits on a grid with a two-cell empty border, so neighbour lookups need no
+    // bounds checks; the cell loop below is branch-free and vectorizes
+    const int W = NUM_COLS + 4;
+    float hit[(NUM_ROWS + 4) * W] = {0};
+    float open[CELLS];
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c) {
+            hit[(r + 2) * W + c + 2] = isHit(r, c) ? 1.0f : 0.0f;
+            open[r * NUM_COLS + c] = isHit(r, c) || isBlocked(r, c) ? 0.0f : 1.0f;
+        }
+    const PolicyScaling &S = policyScaling();
+    const float fleet = afloatCells / S.fleetCells, unknownShare = unknown / static_cast<float>(CELLS);
+    const float anyHit = hits > 0 ? 1.0f : 0.0f;
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c) {
+            const int cell = r * NUM_COLS + c;
+            const float *h = hit + (r + 2) * W + c + 2;
+            const float u = open[cell];
+            float adj = h[-W] + h[W] + h[-1] + h[1];
+            float line = h[-W] * h[-2 * W] + h[W] * h[2 * W] + h[-1] * h[-2] + h[1] * h[2];
+            float diag = h[-W - 1] + h[-W + 1] + h[W - 1] + h[W + 1];
+            int edge = min(min(r, NUM_ROWS - 1 - r), min(c, NUM_COLS - 1 - c));
+            out[0][cell] = u * cover[0][cell] / S.coverMax;
+            out[1][cell] = u * cover[1][cell] / S.coverMax;
+            out[2][cell] = u * cover[2][cell] / S.coverMax;
+            out[3][cell] = u * cover[0][cell] * inv[0];
+            out[4][cell] = u * cover[1][cell] * inv[1];
+            out[5][cell] = u * cover[2][cell] * inv[2];
+            out[6][cell] = u * coverLargest[cell] / S.largestCoverMax;
+            out[7][cell] = coverSmallest[cell] > 0 ? u : 0.0f;
+            out[8][cell] = u * adj / 2.0f;
+            out[9][cell] = u * line;
+            out[10][cell] = u * diag / 2.0f;
+            out[11][cell] = (r + c) % 2 == 0 ? u : 0.0f;
+            out[12][cell] = u * edge / S.edgeMax;
+            out[13][cell] = u * fleet;
+            out[14][cell] = u * unknownShare;
+            out[15][cell] = u * anyHit;
+        }
+}
 
-    double running = 0.0;
-    for (size_t i = 0; i < flat.size(); ++i) {
-        running += flat[i];
-        if (rnd <= running) return coords[i];
+void policyLogits(const PolicyModel &m, const float x[POLICY_FEATURES][NUM_ROWS * NUM_COLS],
+                  float out[NUM_ROWS * NUM_COLS]) {
+    const int CELLS = NUM_ROWS * NUM_COLS;
+    for (int cell = 0; cell < CELLS; ++cell) out[cell] = m.b2;
+    // One hidden unit at a time over every cell: the inner loops run along cells
+    for (int j = 0; j < POLICY_HIDDEN; ++j) {
+        float a[CELLS];
+        for (int cell = 0; cell < CELLS; ++cell) a[cell] = m.b1[j];
+        for (int f = 0; f < POLICY_FEATURES; ++f) {
+            const float w = m.w1[j][f];
+            for (int cell = 0; cell < CELLS; ++cell) a[cell] += w * x[f][cell];
+        }
+        for (int cell = 0; cell < CELLS; ++cell) out[cell] += m.w2[j] * max(a[cell], 0.0f);
     }
-    return coords.back(); // fallback
 }
+
+std::pair<int,int> chooseAIMovePolicy(const PolicyModel &m,
+                                      const char board[NUM_ROWS][NUM_COLS],
+                                      const int remaining[NUM_SHIPS]) {
+    ProfileScope profile(PROFILE_CHOOSE_MOVE);
+    float x[POLICY_FEATURES][NUM_ROWS * NUM_COLS];
+    float y[NUM_ROWS * NUM_COLS];
+    policyFeatures(board, remaining, x);
+    policyLogits(m, x, y);
+    std::pair<int,int> best = {-1, -1};
+    float bestLogit = 0.0f;
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c) {
+            char ch = board[r][c];
+            if (ch == 'X' || ch == 'm' || ch == SUNK) continue;
+            float v = y[r * NUM_COLS + c];
+            if (best.first < 0 || v > bestLogit) {
+                bestLogit = v;
+                best = {r, c};
+            }
+        }
+    return best;
+}
+
+#define INSTANTIATE_ENGINE(RulesT)                                                                                   \
+    template void updateLiveHeatmap<RulesT>(const char[RulesT::ROWS][RulesT::COLS],                                  \
+                                            double[RulesT::ROWS][RulesT::COLS], const int[]);                        \
+    template void computePlacementProbabilities<RulesT>(const char[RulesT::ROWS][RulesT::COLS], const int[],         \
+                                                        double[RulesT::ROWS][RulesT::COLS]);                         \
+    template void monteCarloProbabilities<RulesT>(const char[RulesT::ROWS][RulesT::COLS], const int[], int,          \
+                                                  double[RulesT::ROWS][RulesT::COLS]);                               \
+    template pair<int,int> getSmartMove<RulesT>(const char[RulesT::ROWS][RulesT::COLS],                              \
+                                                double[RulesT::ROWS][RulesT::COLS]);                                 \
+    template void generatePlacementWeights<RulesT>(double[RulesT::ROWS][RulesT::COLS]);                              \
+    template pair<int,int> pickWeightedCell<RulesT>(double[RulesT::ROWS][RulesT::COLS]);                             \
+    template bool isCellAvailable<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int);                         \
+    template void enqueueNeighbors<RulesT>(BasicTargetState<RulesT> &, const char[RulesT::ROWS][RulesT::COLS],       \
+                                           int, int);                                                                \
+    template void enqueueOrientedLine<RulesT>(BasicTargetState<RulesT> &, const char[RulesT::ROWS][RulesT::COLS]);   \
+    template std::pair<int,int> chooseAIMove<RulesT>(const char[RulesT::ROWS][RulesT::COLS],                         \
+                                                     double[RulesT::ROWS][RulesT::COLS],                             \
+                                                     double[RulesT::ROWS][RulesT::COLS], BasicTargetState<RulesT> &, \
+                                                     const int[], int);                                              \
+    template std::pair<int,int> chooseAIMoveWithin<RulesT>(const char[RulesT::ROWS][RulesT::COLS],                   \
+                                                           double[RulesT::ROWS][RulesT::COLS],                       \
+                                                           double[RulesT::ROWS][RulesT::COLS],                       \
+                                                           BasicTargetState<RulesT> &, const int[], int, double,     \
+                                                           int *);                                                   \
+    template void chooseAIMovesLanes<RulesT>(const BasicMoveLane<RulesT>[], int, std::pair<int,int>[]);              \
+    template double scoreCell<RulesT>(int, int, const char[RulesT::ROWS][RulesT::COLS],                              \
+                                      double[RulesT::ROWS][RulesT::COLS], double[RulesT::ROWS][RulesT::COLS],        \
+                                      const int[], int);                                                             \
+    template bool scoreCellTerms<RulesT>(int, int, const char[RulesT::ROWS][RulesT::COLS],                           \
+                                         double[RulesT::ROWS][RulesT::COLS], double[RulesT::ROWS][RulesT::COLS],     \
+                                         const int[], int, ScoreTerms &);                                            \
+    template bool shipFitsAt<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int, int, bool);                   \
+    template int shipFitScoreAt<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int, const int[]);              \
+    template double shipFitBiasScoreAt<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int, const int[]);       \
+    template int countConsecutiveHits<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int, int);                \
+    template void updateTargetStateAfterResult<RulesT>(BasicTargetState<RulesT> &,                                  \
+                                                       const char[RulesT::ROWS][RulesT::COLS], int, int, int, bool,  \
+                                                       int[]);                                                       \
+    template struct BasicSunkShips<RulesT>;
+FOR_EACH_GAME_RULES(INSTANTIATE_ENGINE)
@@ -4,13 +4,12 @@
 #include <string>
 #include <utility>
 #include <vector>
-#include <iostream>
 #include <cctype>
-#include <iomanip>
 #include <climits>
 #include <numeric>
 #include <cmath>
 #include "battleship.h"  // NUM_ROWS, NUM_COLS, TargetState, checkShotIsAvailable
+#include "Rules.h"
 
 using namespace std;
 
@@ -38,6 +37,22 @@ extern AIWeights gAIWeights;
 void setAIWeights(const AIWeights &w);
 void getAIWeights(AIWeights &out);
 
+// Weights the engine reads on this thread: those installed by an AIWeightsScope,
+// otherwise gAIWeights
+const AIWeights &aiWeights();
+
+// Installs `w` as this thread's weights until destroyed (null keeps the current ones)
+struct AIWeightsScope {
+    explicit AIWeightsScope(const AIWeights *w);
+    ~AIWeightsScope();
+    const AIWeights *previous;
+};
+
+// Flat layout of AIWeights in declaration order (shared by the WASM bridge and tools)
+const int AI_WEIGHT_COUNT = 16;
+void weightsToArray(const AIWeights &w, double out[AI_WEIGHT_COUNT]);
+void weightsFromArray(const double in[AI_WEIGHT_COUNT], AIWeights &w);
+
 // Log parsing → counts (native builds may provide a stub; WASM has no file I/O)
 void learnFromLog(const string &filename,
                   int hitCount[NUM_ROWS][NUM_COLS],
@@ -51,68 +66,231 @@ void computeProbabilities(int hitCount[NUM_ROWS][NUM_COLS],
 // Heatmap saver (native stub allowed; WASM has no file I/O)
 void saveHeatmap(const string &filename, double hitProb[NUM_ROWS][NUM_COLS]);
 
-void updateLiveHeatmap(const char board[NUM_ROWS][NUM_COLS],
-                       double liveProb[NUM_ROWS][NUM_COLS],
-                       const int remaining[NUM_SHIPS]);
+// The move pipeline below (heatmaps, placement and Monte Carlo maps, move choice,
+// scoring, targeting) is templated on a Rules type (Rules.h) and built for every
+// FOR_EACH_GAME_RULES set; the default is the standard game. Array parameters do
+// not deduce it, so variants name it: chooseAIMove<Rules12x12>(...).
+template <class RulesT = StandardRules>
+void updateLiveHeatmap(const char board[RulesT::ROWS][RulesT::COLS],
+                       double liveProb[RulesT::ROWS][RulesT::COLS],
+                       const int remaining[RulesT::SHIPS]);
 
 // Placement-based probability: enumerate all legal placements for remaining ships
 // and score unshot cells by how many placements would occupy them.
-void computePlacementProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
-                                   const int remaining[NUM_SHIPS],
-                                   double outProb[NUM_ROWS][NUM_COLS]);
+template <class RulesT = StandardRules>
+void computePlacementProbabilities(const char boardView[RulesT::ROWS][RulesT::COLS],
+                                   const int remaining[RulesT::SHIPS],
+                                   double outProb[RulesT::ROWS][RulesT::COLS]);
 
 // Monte-Carlo sampling fallback (optional) - sample many random legal placements
 // and accumulate cell frequencies. Not used by default, but available for experiments.
-void monteCarloProbabilities(const char boardView[NUM_ROWS][NUM_COLS],
-                             const int remaining[NUM_SHIPS],
+// Runs of at least MC_PARALLEL_MIN_ITERATIONS samples are split into MC_CHUNKS
+// chunks with their own seeds, which builds with BATTLESHIP_THREADS spread across
+// WorkerPool::shared(). The split depends only on the sample count, so a map is
+// the same with or without threads and on any pool size. The default 400 samples
+// (about 120 us) stay on one thread, where splitting would cost more than it saves.
+const int MC_PARALLEL_MIN_ITERATIONS = 2000;
+const int MC_CHUNKS = 8;
+// The CUDA sampler serves standard boards only.
+template <class RulesT = StandardRules>
+void monteCarloProbabilities(const char boardView[RulesT::ROWS][RulesT::COLS],
+                             const int remaining[RulesT::SHIPS],
                              int iterations,
-                             double outProb[NUM_ROWS][NUM_COLS]);
+                             double outProb[RulesT::ROWS][RulesT::COLS]);
 
 // Heatmap-driven AI (search mode)
-pair<int,int> getSmartMove(const char board[NUM_ROWS][NUM_COLS],
-                           double hitProb[NUM_ROWS][NUM_COLS]);
+template <class RulesT = StandardRules>
+pair<int,int> getSmartMove(const char board[RulesT::ROWS][RulesT::COLS],
+                           double hitProb[RulesT::ROWS][RulesT::COLS]);
 
 // Biased placement helpers
-void generatePlacementWeights(double weights[NUM_ROWS][NUM_COLS]);
-pair<int,int> pickWeightedCell(double weights[NUM_ROWS][NUM_COLS]);
+template <class RulesT = StandardRules>
+void generatePlacementWeights(double weights[RulesT::ROWS][RulesT::COLS]);
+template <class RulesT = StandardRules>
+pair<int,int> pickWeightedCell(double weights[RulesT::ROWS][RulesT::COLS]);
 
 // Combined search + target mode AI
-bool isCellAvailable(const char board[NUM_ROWS][NUM_COLS], int r, int c);
-void enqueueNeighbors(TargetState &ts, const char board[NUM_ROWS][NUM_COLS], int r, int c);
-void enqueueOrientedLine(TargetState &ts, const char board[NUM_ROWS][NUM_COLS]);
-
-std::pair<int,int> chooseAIMove(const char board[NUM_ROWS][NUM_COLS],
-                                double globalProb[NUM_ROWS][NUM_COLS],
-                                double liveProb[NUM_ROWS][NUM_COLS],
-                                TargetState &ts,
-                                const int remaining[NUM_SHIPS],
+template <class RulesT = StandardRules>
+bool isCellAvailable(const char board[RulesT::ROWS][RulesT::COLS], int r, int c);
+template <class RulesT = StandardRules>
+void enqueueNeighbors(BasicTargetState<RulesT> &ts, const char board[RulesT::ROWS][RulesT::COLS], int r, int c);
+template <class RulesT = StandardRules>
+void enqueueOrientedLine(BasicTargetState<RulesT> &ts, const char board[RulesT::ROWS][RulesT::COLS]);
+
+// Weight of the placement-enumeration map in the live map a move is scored on;
+// the hit-neighbourhood heatmap gets the rest
+const double PLACEMENT_BLEND_RATIO = 0.5;
+
+// Scores cells on the full move map: heatmap, placement blend and, in the endgame
+// (at most mcBlendThresholdCells ship cells and two or more ships left), a Monte
+// Carlo blend of mcIterations samples at mcBlendRatio
+template <class RulesT = StandardRules>
+std::pair<int,int> chooseAIMove(const char board[RulesT::ROWS][RulesT::COLS],
+                                double globalProb[RulesT::ROWS][RulesT::COLS],
+                                double liveProb[RulesT::ROWS][RulesT::COLS],
+                                BasicTargetState<RulesT> &ts,
+                                const int remaining[RulesT::SHIPS],
                                 int turn);
 
+// Anytime variant: runs chooseAIMove's stages in order while the budget allows
+// and scores on the map it got to, so with enough budget it picks the same move.
+// *tierReached receives the last completed MoveTier.
+enum MoveTier { MOVE_TIER_HEURISTIC = 0, MOVE_TIER_PLACEMENT = 1, MOVE_TIER_FULL = 2 };
+template <class RulesT = StandardRules>
+std::pair<int,int> chooseAIMoveWithin(const char board[RulesT::ROWS][RulesT::COLS],
+                                      double globalProb[RulesT::ROWS][RulesT::COLS],
+                                      double liveProb[RulesT::ROWS][RulesT::COLS],
+                                      BasicTargetState<RulesT> &ts,
+                                      const int remaining[RulesT::SHIPS],
+                                      int turn,
+                                      double budgetMs,
+                                      int *tierReached);
+
+// Lockstep move choice for up to MOVE_LANES games at once. Each lane gets exactly
+// the move chooseAIMove would pick for its inputs: same live map, same cell scores,
+// same target-queue and spiral order. Placement counts and the scores of every
+// cell of every lane are computed together from row/column masks, lane-major, so
+// that arithmetic runs across lanes instead of once per game; the heatmap update
+// and endgame Monte Carlo still run per lane.
+const int MOVE_LANES = 16;
+template <class RulesT>
+struct BasicMoveLane {
+    const char (*board)[RulesT::COLS];
+    double (*globalProb)[RulesT::COLS];
+    double (*liveProb)[RulesT::COLS];
+    BasicTargetState<RulesT> *ts;
+    const int *remaining;
+    int turn;
+    // Optional: the shooter's hits, misses and resolved sunk cells as kept by the
+    // round (RoundState::liveHits, ...), read instead of scanning the board
+    const BasicBitboard<RulesT::CELLS> *hits = nullptr;
+    const BasicBitboard<RulesT::CELLS> *misses = nullptr;
+    const BasicBitboard<RulesT::CELLS> *sunk = nullptr;
+};
+typedef BasicMoveLane<StandardRules> MoveLane;
+template <class RulesT>
+void chooseAIMovesLanes(const BasicMoveLane<RulesT> lanes[], int count, std::pair<int,int> moves[]);
 
+template <class RulesT = StandardRules>
 double scoreCell(int r, int c,
-                 const char board[NUM_ROWS][NUM_COLS],
-                 double globalProb[NUM_ROWS][NUM_COLS],
-                 double liveProb[NUM_ROWS][NUM_COLS],
-                 const int remaining[NUM_SHIPS],
+                 const char board[RulesT::ROWS][RulesT::COLS],
+                 double globalProb[RulesT::ROWS][RulesT::COLS],
+                 double liveProb[RulesT::ROWS][RulesT::COLS],
+                 const int remaining[RulesT::SHIPS],
                  int turn);
 
-bool shipFitsAt(const char board[NUM_ROWS][NUM_COLS], int r, int c, int size, bool horiz);
+// The unweighted terms scoreCell combines for one cell (for dataset export and
+// offline fitting); `score` is scoreCell's own value. False when the cell is taken.
+struct ScoreTerms {
+    double global;      // globalProb[r][c]
+    double live;        // liveProb[r][c]
+    double decay;       // exp(-liveDecayFactor * turn), the live term's fade
+    int parity;         // +1 even / -1 odd cell while a ship of 3+ is afloat, else 0
+    int adjHits;        // orthogonal neighbours that are hits
+    int adjLines;       // of those, the ones followed by another hit in line
+    int diagHits;       // diagonal neighbours that are hits
+    bool canFit;        // the smallest remaining ship fits through the cell
+    double fitBias;     // shipFitBiasScoreAt
+    double score;
+};
+template <class RulesT = StandardRules>
+bool scoreCellTerms(int r, int c,
+                    const char board[RulesT::ROWS][RulesT::COLS],
+                    double globalProb[RulesT::ROWS][RulesT::COLS],
+                    double liveProb[RulesT::ROWS][RulesT::COLS],
+                    const int remaining[RulesT::SHIPS],
+                    int turn,
+                    ScoreTerms &out);
+
+template <class RulesT = StandardRules>
+bool shipFitsAt(const char board[RulesT::ROWS][RulesT::COLS], int r, int c, int size, bool horiz);
 
-int shipFitScoreAt(const char board[NUM_ROWS][NUM_COLS], int r, int c, const int remaining[NUM_SHIPS]);
+template <class RulesT = StandardRules>
+int shipFitScoreAt(const char board[RulesT::ROWS][RulesT::COLS], int r, int c, const int remaining[RulesT::SHIPS]);
 
-double shipFitBiasScoreAt(const char board[NUM_ROWS][NUM_COLS],
+template <class RulesT = StandardRules>
+double shipFitBiasScoreAt(const char board[RulesT::ROWS][RulesT::COLS],
                           int r, int c,
-                          const int remaining[NUM_SHIPS]);
+                          const int remaining[RulesT::SHIPS]);
 
 
-int countConsecutiveHits(const char board[NUM_ROWS][NUM_COLS],
+template <class RulesT = StandardRules>
+int countConsecutiveHits(const char board[RulesT::ROWS][RulesT::COLS],
                          int row, int col, int orientation);
 
-void updateTargetStateAfterResult(TargetState &ts,
-                                  const char targetBoard[NUM_ROWS][NUM_COLS],
+template <class RulesT = StandardRules>
+void updateTargetStateAfterResult(BasicTargetState<RulesT> &ts,
+                                  const char targetBoard[RulesT::ROWS][RulesT::COLS],
                                   int shotRow, int shotCol,
                                   int resultShipIndex,
                                   bool sunk,
-                                  int targetShipSizes[NUM_SHIPS]);
+                                  int targetShipSizes[RulesT::SHIPS]);
+
+// Which observed hits belong to ships the shooter has sunk. Each sink keeps the
+// segments of its length through the sinking shot that lie entirely on hits;
+// segments crossing cells that certainly belong to another sunk ship are dropped
+// until nothing changes. Cells shared by all of a ship's remaining segments are
+// resolved: they are no longer evidence for the ships still afloat.
+template <class RulesT>
+struct BasicSunkShips {
+    static_assert(RulesT::CELLS <= 256, "sink cells are stored as bytes");
+    static_assert(RulesT::longestShip() <= 16, "segment offsets are 16-bit fields");
+    typedef BasicBitboard<RulesT::CELLS> Cells;
+    struct Sink {
+        uint8_t cell;           // row * cols + col of the sinking shot
+        uint8_t length;
+        uint32_t candidates;    // bit (vertical ? 16 : 0) + offset of the shot within the segment
+    };
+    Sink sinks[RulesT::SHIPS];
+    int count = 0;
+    Cells cells;                // resolved cells
+
+    void clear() { count = 0; cells.clear(); }
+    // Records a sink at (row, col); `hits` holds every hit so far, including this one
+    void add(const Cells &hits, int row, int col, int length);
+    // Writes SUNK over the resolved cells of `board`
+    void overlay(char board[RulesT::ROWS][RulesT::COLS]) const;
+};
+typedef BasicSunkShips<StandardRules> SunkShips;
+
+// Distilled policy: a fixed-size MLP that maps cheap per-cell features of the
+// shooter's view to the probability that the cell holds a ship, trained offline
+// (`tuner distill`) on the hidden boards of games the full pipeline played. The
+// policy shoots the unknown cell with the highest output; it needs no heatmaps,
+// placement enumeration, Monte Carlo or target queue.
+const int POLICY_FEATURES = 16;
+const int POLICY_HIDDEN = 8;
+struct PolicyModel {
+    float w1[POLICY_HIDDEN][POLICY_FEATURES];
+    float b1[POLICY_HIDDEN];
+    float w2[POLICY_HIDDEN];
+    float b2;
+};
+
+// Divisors that scale the board-dependent features into [0, 1], derived from the
+// board size and SHIP_SIZES. Model files record them, so a model is only loaded by
+// an engine that scales its features the same way.
+struct PolicyScaling {
+    float fleetCells;           // ship cells in a full fleet
+    float coverMax;             // most placements of the whole fleet through one cell
+    float largestCoverMax;      // most placements of the longest ship through one cell
+    float edgeMax;              // largest distance from a cell to the nearest edge
+};
+const PolicyScaling &policyScaling();
+
+// Features of every cell, feature-major (out[f][cell]) so the model runs over all
+// cells at once. Reads only hits ('X'), misses ('m'), resolved sunk cells (SUNK)
+// and which ships are still afloat (remaining[i] > 0); all other cells are
+// unknown. Features of cells that are not unknown are zero.
+void policyFeatures(const char board[NUM_ROWS][NUM_COLS],
+                    const int remaining[NUM_SHIPS],
+                    float out[POLICY_FEATURES][NUM_ROWS * NUM_COLS]);
+// Model output (logit) of every cell
+void policyLogits(const PolicyModel &m, const float x[POLICY_FEATURES][NUM_ROWS * NUM_COLS],
+                  float out[NUM_ROWS * NUM_COLS]);
+// Highest-scoring unknown cell
+std::pair<int,int> chooseAIMovePolicy(const PolicyModel &m,
+                                      const char board[NUM_ROWS][NUM_COLS],
+                                      const int remaining[NUM_SHIPS]);
 
 #endif
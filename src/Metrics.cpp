@@ -0,0 +1,278 @@
+#include "Metrics.h"
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+static std::atomic<EngineMetrics *> gEngineMetrics{nullptr};
+static std::atomic<unsigned> gNextShard{0};
+
+void setEngineMetrics(EngineMetrics *m) { gEngineMetrics.store(m, std::memory_order_release); }
+EngineMetrics *engineMetrics() { return gEngineMetrics.load(std::memory_order_acquire); }
+
+uint64_t metricsNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Histogram::Histogram() : shards(SHARDS) { reset(); }
+
+int Histogram::bucketOf(uint64_t value) {
+    if (value < static_cast<uint64_t>(LINEAR_BUCKETS)) return static_cast<int>(value);
+    int e = 63;
+    while (!(value >> e)) --e;                      // e >= 7 here
+    if (e >= MAX_EXPONENT) return BUCKETS - 1;
+    int sub = static_cast<int>((value >> (e - 6)) & (SUB_BUCKETS - 1));
+    return LINEAR_BUCKETS + (e - 7) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::bucketLow(int bucket) {
+    if (bucket < LINEAR_BUCKETS) return static_cast<uint64_t>(bucket);
+    int e = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 7;
+    uint64_t sub = static_cast<uint64_t>((bucket - LINEAR_BUCKETS) % SUB_BUCKETS);
+    return (SUB_BUCKETS + sub) << (e - 6);
+}
+
+uint64_t Histogram::bucketMid(int bucket) {
+    if (bucket < LINEAR_BUCKETS) return static_cast<uint64_t>(bucket);
+    int e = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 7;
+    return bucketLow(bucket) + ((uint64_t(1) << (e - 6)) >> 1);
+}
+
+void Histogram::record(uint64_t value) {
+    static thread_local unsigned shard = gNextShard++ % SHARDS;
+    Shard &s = shards[shard];
+    s.counts[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    s.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Histogram::reset() {
+    for (Shard &s : shards) {
+        for (auto &c : s.counts) c.store(0, std::memory_order_relaxed);
+        s.sum.store(0, std::memory_order_relaxed);
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot out;
+    for (const Shard &s : shards) {
+        for (int b = 0; b < BUCKETS; ++b) {
+            uint64_t n = s.counts[b].load(std::memory_order_relaxed);
+            out.counts[b] += n;
+            out.total += n;
+        }
+        out.sum += s.sum.load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot &other) {
+    for (int b = 0; b < Histogram::BUCKETS; ++b) counts[b] += other.counts[b];
+    total += other.total;
+    sum += other.sum;
+}
+
+uint64_t HistogramSnapshot::percentile(double p) const {
+    if (total == 0) return 0;
+    // Nearest rank: the smallest value with at least p% of samples at or below it
+    uint64_t rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total) - 1e-9));
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+    uint64_t seen = 0;
+    for (int b = 0; b < Histogram::BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) return Histogram::bucketMid(b);
+    }
+    return Histogram::bucketMid(Histogram::BUCKETS - 1);
+}
+
+struct SparseBin {
+    uint32_t bucket;
+    uint32_t pad;
+    uint64_t count;
+};
+
+bool HistogramSnapshot::write(FILE *f) const {
+    std::vector<SparseBin> bins;
+    for (int b = 0; b < Histogram::BUCKETS; ++b)
+        if (counts[b]) bins.push_back(SparseBin{static_cast<uint32_t>(b), 0, counts[b]});
+    uint64_t head[2] = {sum, bins.size()};
+    if (fwrite(head, sizeof(head), 1, f) != 1) return false;
+    return bins.empty() || fwrite(bins.data(), sizeof(SparseBin), bins.size(), f) == bins.size();
+}
+
+bool HistogramSnapshot::read(FILE *f) {
+    uint64_t head[2];
+    if (fread(head, sizeof(head), 1, f) != 1 || head[1] > static_cast<uint64_t>(Histogram::BUCKETS)) return false;
+    std::vector<SparseBin> bins(head[1]);
+    if (!bins.empty() && fread(bins.data(), sizeof(SparseBin), bins.size(), f) != bins.size()) return false;
+    counts.assign(Histogram::BUCKETS, 0);
+    total = 0;
+    sum = head[0];
+    for (const SparseBin &bin : bins) {
+        if (bin.bucket >= static_cast<uint32_t>(Histogram::BUCKETS)) return false;
+        counts[bin.bucket] += bin.count;
+        total += bin.count;
+    }
+    return true;
+}
+
+// ---- Phase profiler ----
+
+std::atomic<int> gProfileMode{PROFILE_OFF};
+
+static const char *PROFILE_PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+    "tick", "chooseAIMove", "updateLiveHeatmap", "placementProbabilities",
+    "monteCarlo", "scoreCell", "updateTargetState",
+};
+static const bool PROFILE_PHASE_TRACED[PROFILE_PHASE_COUNT] = {
+    true, true, true, true, true, false, true,
+};
+
+// Trace buffers across all threads stop growing here (24 bytes per event)
+static const uint64_t MAX_TRACE_EVENTS = 1u << 20;
+
+struct TraceEvent {
+    uint64_t start;
+    uint32_t dur;
+    uint32_t phase;
+};
+
+// One recording thread. Only the owner writes; counters are atomics so a
+// summary taken mid-run reads whole values.
+struct ProfileThread {
+    int tid = 0;
+    std::atomic<uint64_t> calls[PROFILE_PHASE_COUNT];
+    std::atomic<uint64_t> ns[PROFILE_PHASE_COUNT];
+    std::vector<TraceEvent> events;
+};
+
+static std::mutex gProfileMtx;
+static std::vector<std::unique_ptr<ProfileThread>> gProfileThreads;  // outlive their threads
+static std::atomic<uint64_t> gTraceEvents{0};
+static std::atomic<uint64_t> gTraceDropped{0};
+static std::atomic<uint64_t> gTraceBaseNs{0};
+
+static ProfileThread &profileThread() {
+    static thread_local ProfileThread *self = nullptr;
+    if (!self) {
+        std::unique_ptr<ProfileThread> t(new ProfileThread());
+        for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) { t->calls[p] = 0; t->ns[p] = 0; }
+        std::lock_guard<std::mutex> lock(gProfileMtx);
+        t->tid = static_cast<int>(gProfileThreads.size()) + 1;
+        self = t.get();
+        gProfileThreads.push_back(std::move(t));
+    }
+    return *self;
+}
+
+void setProfileMode(int mode) {
+    if (mode < PROFILE_OFF || mode > PROFILE_TRACE) mode = PROFILE_OFF;
+    uint64_t none = 0;
+    if (mode == PROFILE_TRACE) gTraceBaseNs.compare_exchange_strong(none, metricsNowNs());
+    gProfileMode.store(mode, std::memory_order_relaxed);
+}
+
+const char *profilePhaseName(int phase) {
+    return phase >= 0 && phase < PROFILE_PHASE_COUNT ? PROFILE_PHASE_NAMES[phase] : "";
+}
+
+void profileRecord(ProfilePhase phase, uint64_t t0, uint64_t t1) {
+    ProfileThread &t = profileThread();
+    uint64_t dur = t1 - t0;
+    t.calls[phase].store(t.calls[phase].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    t.ns[phase].store(t.ns[phase].load(std::memory_order_relaxed) + dur, std::memory_order_relaxed);
+    if (!PROFILE_PHASE_TRACED[phase] || gProfileMode.load(std::memory_order_relaxed) != PROFILE_TRACE) return;
+    if (gTraceEvents.fetch_add(1, std::memory_order_relaxed) >= MAX_TRACE_EVENTS) {
+        gTraceDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    t.events.push_back(TraceEvent{t0, static_cast<uint32_t>(dur < 0xFFFFFFFFu ? dur : 0xFFFFFFFFu),
+                                  static_cast<uint32_t>(phase)});
+}
+
+void resetProfile() {
+    std::lock_guard<std::mutex> lock(gProfileMtx);
+    for (auto &t : gProfileThreads) {
+        for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) { t->calls[p] = 0; t->ns[p] = 0; }
+        t->events.clear();
+        t->events.shrink_to_fit();
+    }
+    gTraceEvents = 0;
+    gTraceDropped = 0;
+    gTraceBaseNs = gProfileMode.load() == PROFILE_TRACE ? metricsNowNs() : 0;
+}
+
+ProfileTotals profileTotals() {
+    ProfileTotals out;
+    std::lock_guard<std::mutex> lock(gProfileMtx);
+    for (auto &t : gProfileThreads) {
+        bool used = false;
+        for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+            uint64_t c = t->calls[p].load(std::memory_order_relaxed);
+            out.calls[p] += c;
+            out.ns[p] += t->ns[p].load(std::memory_order_relaxed);
+            used = used || c > 0;
+        }
+        if (used) out.threads++;
+        out.traceEvents += t->events.size();
+    }
+    out.droppedEvents = gTraceDropped.load(std::memory_order_relaxed);
+    return out;
+}
+
+std::string profileSummary() {
+    ProfileTotals tot = profileTotals();
+    uint64_t maxNs[PROFILE_PHASE_COUNT] = {0};
+    {
+        std::lock_guard<std::mutex> lock(gProfileMtx);
+        for (auto &t : gProfileThreads)
+            for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+                uint64_t v = t->ns[p].load(std::memory_order_relaxed);
+                if (v > maxNs[p]) maxNs[p] = v;
+            }
+    }
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-24s %12s %12s %10s %14s\n",
+                  "phase", "calls", "total_ms", "mean_us", "thread_max_ms");
+    out += line;
+    for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+        std::snprintf(line, sizeof(line), "%-24s %12llu %12.3f %10.3f %14.3f\n",
+                      PROFILE_PHASE_NAMES[p], static_cast<unsigned long long>(tot.calls[p]),
+                      tot.ns[p] * 1e-6, tot.calls[p] ? tot.ns[p] * 1e-3 / tot.calls[p] : 0.0, maxNs[p] * 1e-6);
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "threads: %d  trace events: %llu (dropped %llu)\n", tot.threads,
+                  static_cast<unsigned long long>(tot.traceEvents), static_cast<unsigned long long>(tot.droppedEvents));
+    out += line;
+    return out;
+}
+
+std::string profileTraceJson() {
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    uint64_t base = gTraceBaseNs.load();
+    char buf[192];
+    bool first = true;
+    std::lock_guard<std::mutex> lock(gProfileMtx);
+    for (auto &t : gProfileThreads) {
+        if (t->events.empty()) continue;
+        std::snprintf(buf, sizeof(buf),
+                      "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"engine %d\"}}",
+                      first ? "" : ",", t->tid, t->tid);
+        out += buf;
+        first = false;
+        for (const TraceEvent &e : t->events) {
+            // Chrome expects microseconds
+            std::snprintf(buf, sizeof(buf),
+                          ",\n{\"name\":\"%s\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                          PROFILE_PHASE_NAMES[e.phase], t->tid,
+                          e.start >= base ? (e.start - base) * 1e-3 : 0.0, e.dur * 1e-3);
+            out += buf;
+        }
+    }
+    std::snprintf(buf, sizeof(buf), "\n],\"otherData\":{\"droppedEvents\":%llu}}\n",
+                  static_cast<unsigned long long>(gTraceDropped.load()));
+    out += buf;
+    return out;
+}
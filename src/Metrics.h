@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Log-linear histogram of non-negative integer samples (shot counts, nanoseconds).
+//
+// Values below LINEAR_BUCKETS get a bucket each, so shot counts are exact; larger
+// values share SUB_BUCKETS buckets per power of two (under 2% relative error).
+// Any number of threads may record() at once: each thread adds to one of SHARDS
+// cache-line-aligned copies with relaxed atomic increments, and snapshot() sums
+// the shards. Snapshots merge by adding counts, so partial results from threads,
+// shards or processes combine exactly.
+struct HistogramSnapshot;
+
+class Histogram {
+public:
+    static const int SHARDS = 8;
+    static const int LINEAR_BUCKETS = 128;
+    static const int SUB_BUCKETS = 64;
+    static const int MAX_EXPONENT = 40;     // values >= 2^40 land in the last bucket
+    static const int BUCKETS = LINEAR_BUCKETS + (MAX_EXPONENT - 7) * SUB_BUCKETS;
+
+    Histogram();
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    void record(uint64_t value);
+    // Not safe while other threads are recording
+    void reset();
+    HistogramSnapshot snapshot() const;
+
+    static int bucketOf(uint64_t value);
+    // Smallest value mapped to the bucket / a representative value for it
+    static uint64_t bucketLow(int bucket);
+    static uint64_t bucketMid(int bucket);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counts[BUCKETS];
+        std::atomic<uint64_t> sum;
+    };
+    std::vector<Shard> shards;
+};
+
+// Plain counts taken from a Histogram
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts = std::vector<uint64_t>(Histogram::BUCKETS, 0);
+    uint64_t total = 0;
+    uint64_t sum = 0;
+
+    void merge(const HistogramSnapshot &other);
+    // Value at percentile p (0-100); 0 when empty
+    uint64_t percentile(double p) const;
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.0; }
+
+    // Sparse binary form (non-zero buckets only) used by tuner shard files
+    bool write(FILE *f) const;
+    bool read(FILE *f);
+};
+
+// Histograms the engine records into while a set is installed
+struct EngineMetrics {
+    Histogram moveLatencyNs;    // one AI move decision (RoundState::tick)
+    Histogram mcTimeNs;         // one monteCarloProbabilities call
+
+    void reset() { moveLatencyNs.reset(); mcTimeNs.reset(); }
+};
+
+// Process-wide sink; null (the default) turns timing off
+void setEngineMetrics(EngineMetrics *m);
+EngineMetrics *engineMetrics();
+
+// Nanoseconds on a monotonic clock
+uint64_t metricsNowNs();
+
+// Records how long the enclosing scope took into `h` (nothing when h is null)
+struct HistogramTimer {
+    explicit HistogramTimer(Histogram *h_) : h(h_), t0(h_ ? metricsNowNs() : 0) {}
+    ~HistogramTimer() { if (h) h->record(metricsNowNs() - t0); }
+    HistogramTimer(const HistogramTimer &) = delete;
+    HistogramTimer &operator=(const HistogramTimer &) = delete;
+    Histogram *h;
+    uint64_t t0;
+};
+
+// Hot-path phases timed by ProfileScope. Times are inclusive: a tick contains
+// the move choice, which contains the heatmap, placement and scoring phases.
+enum ProfilePhase {
+    PROFILE_TICK,               // RoundState::tick (one move)
+    PROFILE_CHOOSE_MOVE,        // chooseAIMove / chooseAIMoveWithin
+    PROFILE_LIVE_HEATMAP,       // updateLiveHeatmap
+    PROFILE_PLACEMENT,          // computePlacementProbabilities
+    PROFILE_MONTE_CARLO,        // monteCarloProbabilities
+    PROFILE_SCORE_CELL,         // scoreCell (counted, not traced: ~100 calls per move)
+    PROFILE_TARGET_UPDATE,      // updateTargetStateAfterResult
+    PROFILE_PHASE_COUNT
+};
+
+enum ProfileMode {
+    PROFILE_OFF = 0,            // scopes cost one relaxed load
+    PROFILE_COUNTERS = 1,       // per-thread call counts and total time per phase
+    PROFILE_TRACE = 2,          // counters plus one trace event per scope
+};
+
+// Runtime switch read by every ProfileScope
+extern std::atomic<int> gProfileMode;
+
+void setProfileMode(int mode);
+const char *profilePhaseName(int phase);
+void profileRecord(ProfilePhase phase, uint64_t t0, uint64_t t1);
+
+// Times the enclosing scope as `phase` while profiling is on
+struct ProfileScope {
+    explicit ProfileScope(ProfilePhase p)
+        : phase(p), on(gProfileMode.load(std::memory_order_relaxed) != PROFILE_OFF),
+          t0(on ? metricsNowNs() : 0) {}
+    ~ProfileScope() { if (on) profileRecord(phase, t0, metricsNowNs()); }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+    ProfilePhase phase;
+    bool on;
+    uint64_t t0;
+};
+
+// Counters summed over every thread that has recorded
+struct ProfileTotals {
+    uint64_t calls[PROFILE_PHASE_COUNT] = {0};
+    uint64_t ns[PROFILE_PHASE_COUNT] = {0};
+    int threads = 0;
+    uint64_t traceEvents = 0;
+    uint64_t droppedEvents = 0;     // past the trace buffer cap
+};
+
+// The functions below read or clear per-thread buffers: call them while no
+// engine thread is inside a profiled scope (between runs).
+void resetProfile();
+ProfileTotals profileTotals();
+// Fixed-width table: phase, calls, total ms, mean us, per-thread max ms
+std::string profileSummary();
+// Chrome trace-event JSON (chrome://tracing, Perfetto), one track per thread
+std::string profileTraceJson();
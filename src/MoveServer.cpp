@@ -0,0 +1,426 @@
+#include "MoveServer.h"
+#include "Tournament.h"
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t gServerStop = 0;
+static void onServerSignal(int) { gServerStop = 1; }
+
+static bool readFull(int fd, void *buf, size_t n) {
+    char *p = static_cast<char *>(buf);
+    while (n > 0) {
+        ssize_t k = ::read(fd, p, n);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return false;
+        p += k;
+        n -= static_cast<size_t>(k);
+    }
+    return true;
+}
+
+static bool writeFull(int fd, const void *buf, size_t n) {
+    const char *p = static_cast<const char *>(buf);
+    while (n > 0) {
+        ssize_t k = ::write(fd, p, n);
+        if (k < 0 && errno == EINTR) continue;
+        if (k < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd w{fd, POLLOUT, 0};
+            ::poll(&w, 1, -1);
+            continue;
+        }
+        if (k <= 0) return false;
+        p += k;
+        n -= static_cast<size_t>(k);
+    }
+    return true;
+}
+
+void makeMoveRequest(const char board[NUM_ROWS][NUM_COLS], const int remaining[NUM_SHIPS], int turn,
+                     uint16_t weightsId, uint32_t tag, MoveRequest &req) {
+    std::memset(&req, 0, sizeof(req));
+    req.tag = tag;
+    req.weightsId = weightsId;
+    req.turn = static_cast<uint16_t>(turn);
+    for (int i = 0; i < NUM_SHIPS; ++i) req.remaining[i] = static_cast<int8_t>(remaining[i]);
+    // Only what the shooter has observed; hidden ship symbols read as unknown
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c) {
+            char ch = board[r][c];
+            req.view[r * NUM_COLS + c] = (ch == HIT || ch == MISS || ch == SUNK) ? ch : '-';
+        }
+}
+
+namespace {
+
+struct Connection {
+    Connection() = default;
+    Connection(int inFd, int outFd) : in(inFd), out(outFd) {}
+
+    int in = -1, out = -1;
+    std::vector<char> pending;          // bytes read but not yet framed
+    bool readable = true;               // false after EOF or a bad frame; replies still go out
+    bool writable = true;
+};
+
+struct QueuedRequest {
+    size_t conn;
+    MoveRequest req;
+    uint64_t arrivalNs;
+};
+
+// One lane's inputs and live map
+struct Slot {
+    char board[NUM_ROWS][NUM_COLS];
+    double liveProb[NUM_ROWS][NUM_COLS];
+    TargetState ts;
+    int remaining[NUM_SHIPS];
+};
+
+bool validRequest(const MoveRequest &q) {
+    for (int i = 0; i < NUM_SHIPS; ++i)
+        if (q.remaining[i] < 0 || q.remaining[i] > SHIP_SIZES[i]) return false;
+    for (int k = 0; k < NUM_ROWS * NUM_COLS; ++k) {
+        char ch = q.view[k];
+        if (ch != '-' && ch != HIT && ch != MISS && ch != SUNK) return false;
+    }
+    return true;
+}
+
+// Inputs of chooseAIMove for a stateless request: the board as given, and a target
+// queue holding the open neighbours of every unresolved hit
+void fillSlot(const MoveRequest &q, Slot &s) {
+    std::memcpy(s.board, q.view, sizeof(s.board));
+    for (int i = 0; i < NUM_SHIPS; ++i) s.remaining[i] = q.remaining[i];
+    s.ts = TargetState{};
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c)
+            if (s.board[r][c] == HIT) {
+                enqueueNeighbors(s.ts, s.board, r, c);
+                s.ts.lastHitRow = r;
+                s.ts.lastHitCol = c;
+            }
+    s.ts.active = !s.ts.queue.empty();
+}
+
+class Server {
+public:
+    Server(const MoveServerConfig &cfg_, MoveServerStats &stats_) : cfg(cfg_), stats(stats_) {
+        PlacementPrior blank;
+        blank.reset();
+        blank.read(globalProb);
+    }
+
+    bool run() {
+        if (cfg.socketPath.empty()) {
+            conns.emplace_back(STDIN_FILENO, STDOUT_FILENO);
+            stats.connections = 1;
+        } else if (!listenOn(cfg.socketPath)) {
+            return false;
+        }
+        struct sigaction sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = onServerSignal;
+        sigaction(SIGINT, &sa, nullptr);
+        sigaction(SIGTERM, &sa, nullptr);
+        signal(SIGPIPE, SIG_IGN);
+
+        uint64_t windowStart = 0;
+        while (!gServerStop) {
+            if (queue.empty()) dropClosed();
+            if (listener < 0 && conns.empty()) break;
+
+            // Block until input arrives; once a partial batch is waiting, only until its window closes
+            int timeoutMs = -1;
+            if (!queue.empty()) {
+                uint64_t waited = metricsNowNs() - windowStart;
+                uint64_t window = static_cast<uint64_t>(cfg.windowUs) * 1000;
+                timeoutMs = waited >= window ? 0 : static_cast<int>((window - waited + 999999) / 1000000);
+            }
+            std::vector<pollfd> fds;
+            if (listener >= 0) fds.push_back(pollfd{listener, POLLIN, 0});
+            for (const Connection &c : conns) fds.push_back(pollfd{c.readable ? c.in : -1, POLLIN, 0});
+            int ready = ::poll(fds.data(), fds.size(), timeoutMs);
+            if (ready < 0 && errno != EINTR) break;
+
+            size_t base = 0;
+            if (listener >= 0) {
+                if (ready > 0 && (fds[0].revents & POLLIN)) acceptAll();
+                base = 1;
+            }
+            size_t queuedBefore = queue.size();
+            for (size_t k = 0; ready > 0 && k + base < fds.size(); ++k)
+                if (fds[k + base].revents & (POLLIN | POLLHUP | POLLERR)) readFrom(k);
+            if (queuedBefore == 0 && !queue.empty()) windowStart = metricsNowNs();
+
+            bool full = queue.size() >= static_cast<size_t>(MOVE_LANES);
+            bool windowOver = metricsNowNs() - windowStart >= static_cast<uint64_t>(cfg.windowUs) * 1000;
+            if (!queue.empty() && (full || windowOver || cfg.windowUs <= 0)) serveQueue();
+        }
+        for (Connection &c : conns) c.readable = false;
+        dropClosed();
+        if (listener >= 0) {
+            ::close(listener);
+            ::unlink(cfg.socketPath.c_str());
+        }
+        return true;
+    }
+
+private:
+    const MoveServerConfig &cfg;
+    MoveServerStats &stats;
+    int listener = -1;
+    std::vector<Connection> conns;
+    std::vector<QueuedRequest> queue;
+    double globalProb[NUM_ROWS][NUM_COLS];
+
+    bool listenOn(const std::string &path) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        std::strcpy(addr.sun_path, path.c_str());
+        listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) return false;
+        ::unlink(path.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(listener, 64) != 0) {
+            ::close(listener);
+            listener = -1;
+            return false;
+        }
+        fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+        return true;
+    }
+
+    void acceptAll() {
+        for (int fd; (fd = ::accept(listener, nullptr, nullptr)) >= 0; ) {
+            conns.emplace_back(fd, fd);
+            stats.connections++;
+        }
+    }
+
+    // Closes connections that will send nothing more (all their requests are answered)
+    void dropClosed() {
+        size_t kept = 0;
+        for (Connection &c : conns) {
+            if (c.readable) {
+                if (&conns[kept] != &c) conns[kept] = std::move(c);
+                kept++;
+            }
+            else if (c.in > STDERR_FILENO) ::close(c.in);
+        }
+        conns.resize(kept);
+    }
+
+    void readFrom(size_t k) {
+        Connection &c = conns[k];
+        char buf[16384];
+        ssize_t n = ::read(c.in, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) return;
+        if (n <= 0) {
+            c.readable = false;
+            return;
+        }
+        c.pending.insert(c.pending.end(), buf, buf + n);
+        size_t at = 0;
+        uint64_t now = metricsNowNs();
+        while (c.pending.size() - at >= 4) {
+            uint32_t len;
+            std::memcpy(&len, c.pending.data() + at, 4);
+            if (len != sizeof(MoveRequest)) {
+                // A frame of the wrong size cannot be resynchronized: reject it and drop the connection
+                MoveResponse bad;
+                std::memset(&bad, 0, sizeof(bad));
+                bad.status = MOVE_BAD_REQUEST;
+                bad.row = bad.col = 255;
+                reply(c, bad);
+                c.readable = false;
+                c.pending.clear();
+                return;
+            }
+            if (c.pending.size() - at < 4 + len) break;
+            QueuedRequest q;
+            q.conn = k;
+            std::memcpy(&q.req, c.pending.data() + at + 4, sizeof(MoveRequest));
+            q.arrivalNs = now;
+            queue.push_back(q);
+            at += 4 + len;
+        }
+        c.pending.erase(c.pending.begin(), c.pending.begin() + at);
+    }
+
+    void reply(Connection &c, const MoveResponse &resp) {
+        if (!c.writable) return;
+        char frame[4 + sizeof(MoveResponse)];
+        uint32_t len = sizeof(MoveResponse);
+        std::memcpy(frame, &len, 4);
+        std::memcpy(frame + 4, &resp, sizeof(resp));
+        if (!writeFull(c.out, frame, sizeof(frame))) c.writable = false;
+    }
+
+    void finish(const QueuedRequest &q, MoveResponse &resp) {
+        resp.tag = q.req.tag;
+        uint64_t ns = metricsNowNs() - q.arrivalNs;
+        resp.serverNs = static_cast<uint32_t>(ns > UINT32_MAX ? UINT32_MAX : ns);
+        stats.latencyNs.record(ns);
+        stats.requests++;
+        reply(conns[q.conn], resp);
+    }
+
+    // Answers every queued request: invalid ones at once, the rest in batches of
+    // up to MOVE_LANES sharing a weights id, in arrival order within each id
+    void serveQueue() {
+        std::vector<QueuedRequest> work;
+        work.swap(queue);
+        std::vector<bool> done(work.size(), false);
+        for (size_t i = 0; i < work.size(); ++i) {
+            const MoveRequest &q = work[i].req;
+            MoveResponse resp;
+            std::memset(&resp, 0, sizeof(resp));
+            resp.row = resp.col = 255;
+            if (!validRequest(q)) resp.status = MOVE_BAD_REQUEST;
+            else if (q.weightsId > cfg.weights.size()) resp.status = MOVE_UNKNOWN_WEIGHTS;
+            else continue;
+            finish(work[i], resp);
+            done[i] = true;
+        }
+
+        Slot slots[MOVE_LANES];
+        MoveLane lanes[MOVE_LANES];
+        size_t members[MOVE_LANES];
+        for (size_t i = 0; i < work.size(); ++i) {
+            if (done[i]) continue;
+            const uint16_t id = work[i].req.weightsId;
+            int n = 0;
+            for (size_t j = i; j < work.size() && n < MOVE_LANES; ++j) {
+                if (done[j] || work[j].req.weightsId != id) continue;
+                Slot &s = slots[n];
+                fillSlot(work[j].req, s);
+                lanes[n] = MoveLane{s.board, globalProb, s.liveProb, &s.ts, s.remaining, work[j].req.turn};
+                members[n++] = j;
+                done[j] = true;
+            }
+            std::pair<int,int> moves[MOVE_LANES];
+            {
+                AIWeightsScope useWeights(id > 0 ? &cfg.weights[id - 1] : nullptr);
+                chooseAIMovesLanes(lanes, n, moves);
+            }
+            stats.batches++;
+            for (int l = 0; l < n; ++l) {
+                MoveResponse resp;
+                resp.status = MOVE_OK;
+                resp.row = static_cast<uint8_t>(moves[l].first);
+                resp.col = static_cast<uint8_t>(moves[l].second);
+                resp.batch = static_cast<uint8_t>(n);
+                for (int r = 0; r < NUM_ROWS; ++r)
+                    for (int c = 0; c < NUM_COLS; ++c)
+                        resp.heat[r * NUM_COLS + c] = static_cast<float>(slots[l].liveProb[r][c]);
+                finish(work[members[l]], resp);
+            }
+        }
+    }
+};
+
+} // namespace
+
+bool runMoveServer(const MoveServerConfig &cfg, MoveServerStats &stats) {
+    gServerStop = 0;
+    Server server(cfg, stats);
+    return server.run();
+}
+
+bool MoveClient::connect(const std::string &socketPath) {
+    close();
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) return false;
+    std::strcpy(addr.sun_path, socketPath.c_str());
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MoveClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+bool MoveClient::call(const MoveRequest &req, MoveResponse &resp) {
+    char frame[4 + sizeof(MoveRequest)];
+    uint32_t len = sizeof(MoveRequest);
+    std::memcpy(frame, &len, 4);
+    std::memcpy(frame + 4, &req, sizeof(req));
+    if (!writeFull(fd, frame, sizeof(frame))) return false;
+    return readFull(fd, &len, 4) && len == sizeof(MoveResponse) && readFull(fd, &resp, sizeof(resp));
+}
+
+LoadGenResult runLoadGenerator(const std::string &socketPath, int clients, long long games, uint64_t seed,
+                               uint16_t weightsId) {
+    if (clients < 1) clients = 1;
+    LoadGenResult result;
+    Histogram roundTrip, server;
+    std::atomic<long long> nextGame{0}, requests{0}, shots{0}, batchSum{0}, played{0};
+    std::atomic<bool> failed{false};
+    uint64_t t0 = metricsNowNs();
+    std::vector<std::thread> ths;
+    for (int k = 0; k < clients; ++k)
+        ths.emplace_back([&, k] {
+            MoveClient client;
+            if (!client.connect(socketPath)) { failed = true; return; }
+            for (long long g; !failed && (g = nextGame++) < games; ) {
+                // One game per claim, seeded like sweep game g; the server picks every move
+                Tournament t;
+                t.current.logMoves = false;
+                t.current.liveMaps = false;
+                t.start(3, 1, seed, g);
+                uint32_t tag = 0;
+                while (!t.done()) {
+                    RoundState &rs = t.current;
+                    char board[NUM_ROWS][NUM_COLS];
+                    rs.aiBoard(rs.turn, board);
+                    const int *remaining = rs.turn == 0 ? rs.computerShipSizes : rs.playerShipSizes;
+                    MoveRequest req;
+                    MoveResponse resp;
+                    makeMoveRequest(board, remaining, rs.turnCount, weightsId, tag++, req);
+                    uint64_t sent = metricsNowNs();
+                    if (!client.call(req, resp) || resp.tag != req.tag || resp.status != MOVE_OK) {
+                        failed = true;
+                        break;
+                    }
+                    roundTrip.record(metricsNowNs() - sent);
+                    server.record(resp.serverNs);
+                    requests++;
+                    batchSum += resp.batch;
+                    rs.fire(resp.row, resp.col);
+                    TickEvent ev;
+                    t.afterTick(&ev);
+                    if (ev.flags & TICK_ROUND_END) {
+                        shots += ev.shotsP1 + ev.shotsP2;
+                        played++;
+                    }
+                }
+            }
+        });
+    for (auto &th : ths) th.join();
+    result.seconds = (metricsNowNs() - t0) / 1e9;
+    result.games = played;
+    result.requests = requests;
+    result.shots = shots;
+    result.batchSum = batchSum;
+    result.roundTripNs = roundTrip.snapshot();
+    result.serverNs = server.snapshot();
+    result.ok = !failed;
+    return result;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MLforAI.h"
+#include "Metrics.h"
+
+// Move server: answers "best move for this view" over a Unix domain socket or
+// stdin/stdout.
+//
+// Every message is a frame: a little-endian uint32 payload length, then the
+// payload. Requests are MoveRequest, replies MoveResponse, one reply per request
+// carrying its tag (rejected requests are answered ahead of a batch). Requests
+// are stateless: the global map is the blank-board placement map, and the target
+// queue is rebuilt from the view's unresolved hits (their open neighbours). A
+// single-threaded poll loop gathers what every connection has sent, then scores
+// it in batches of up to MOVE_LANES requests with the same weights through
+// chooseAIMovesLanes.
+
+struct MoveRequest {
+    uint32_t tag;                       // echoed in the reply
+    uint16_t weightsId;                 // 0: the server's default weights, k: the k-th loaded set
+    uint16_t turn;                      // shots the requester has fired (drives the live term's decay)
+    int8_t remaining[8];                // health left per ship, first NUM_SHIPS used (0 = sunk)
+    char view[NUM_ROWS * NUM_COLS];     // row-major: '-' unknown, 'X' hit, 'm' miss, SUNK resolved
+};
+
+enum MoveStatus { MOVE_OK = 0, MOVE_BAD_REQUEST = 1, MOVE_UNKNOWN_WEIGHTS = 2 };
+
+struct MoveResponse {
+    uint32_t tag;
+    uint8_t status;                     // MoveStatus
+    uint8_t row, col;                   // 255 unless status is MOVE_OK
+    uint8_t batch;                      // requests scored together with this one
+    uint32_t serverNs;                  // from the request's arrival to its reply
+    float heat[NUM_ROWS * NUM_COLS];    // live placement map the move was scored with
+};
+static_assert(sizeof(MoveRequest) == 16 + NUM_ROWS * NUM_COLS, "requests are packed");
+static_assert(sizeof(MoveResponse) == 12 + 4 * NUM_ROWS * NUM_COLS, "replies are packed");
+
+struct MoveServerConfig {
+    std::string socketPath;             // listen here; empty: serve stdin/stdout
+    std::vector<AIWeights> weights;     // weightsId k > 0 selects weights[k - 1]
+    int windowUs = 0;                   // wait this long for a batch to fill (0: score what has arrived)
+};
+
+struct MoveServerStats {
+    long long requests = 0;
+    long long batches = 0;
+    long long connections = 0;
+    Histogram latencyNs;                // arrival to reply, per request
+};
+
+// Serves until stdin closes (stdio mode) or SIGINT / SIGTERM; false when the
+// socket cannot be set up
+bool runMoveServer(const MoveServerConfig &cfg, MoveServerStats &stats);
+
+// Fills `req` from a board as the AI sees it (RoundState::aiBoard) and the
+// target's remaining ship health
+void makeMoveRequest(const char board[NUM_ROWS][NUM_COLS], const int remaining[NUM_SHIPS], int turn,
+                     uint16_t weightsId, uint32_t tag, MoveRequest &req);
+
+// Blocking client for one connection
+struct MoveClient {
+    int fd = -1;
+
+    MoveClient() = default;
+    MoveClient(const MoveClient &) = delete;
+    MoveClient &operator=(const MoveClient &) = delete;
+    ~MoveClient() { close(); }
+
+    bool connect(const std::string &socketPath);
+    void close();
+    // Sends one request and waits for its reply
+    bool call(const MoveRequest &req, MoveResponse &resp);
+};
+
+// Load generator: `clients` connections each play CvC games (seeded like a
+// sweep, `games` in total) with every move chosen by the server
+struct LoadGenResult {
+    long long games = 0;
+    long long requests = 0;
+    long long shots = 0;                // shots to finish, both players, all games
+    long long batchSum = 0;             // sum of reported batch sizes
+    double seconds = 0.0;
+    bool ok = false;
+    HistogramSnapshot roundTripNs;      // client-side
+    HistogramSnapshot serverNs;         // as reported by the server
+};
+LoadGenResult runLoadGenerator(const std::string &socketPath, int clients, long long games, uint64_t seed,
+                               uint16_t weightsId);
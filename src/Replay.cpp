@@ -0,0 +1,84 @@
+#include "Replay.h"
+
+template <class RulesT>
+void replayGame(uint64_t masterSeed, long long gameIndex, const AIWeights &w,
+                BasicReplayResult<RulesT> &out, int stopAfterMove, int blockGames,
+                const typename BasicReplayResult<RulesT>::Layout *layouts, long long layoutCount, bool learnPrior) {
+    if (blockGames < 1) blockGames = 1;
+    long long blockStart = (gameIndex / blockGames) * blockGames;
+    int target = static_cast<int>(gameIndex - blockStart);
+
+    AIWeightsScope useWeights(&w);
+
+    out.moves.clear();
+    out.shotsP1 = out.shotsP2 = 0;
+    out.winner = -1;
+
+    BasicTournament<RulesT> t;
+    t.layouts = layouts;
+    t.layoutCount = layoutCount;
+    t.learnPrior = learnPrior;
+    if (learnPrior) {
+        // Fast-forward the block's earlier rounds to rebuild the prior they leave
+        t.start(3, target + 1, masterSeed, blockStart);
+        while (t.currentRoundIdx < target) t.tick();
+    } else {
+        // Without a prior, rounds share nothing: start at the game itself, numbered
+        // as in its block
+        t.start(3, 1, masterSeed, gameIndex);
+        t.current.roundIndex = target + 1;
+    }
+
+    BasicRoundState<RulesT> &rs = t.current;
+    while (!rs.isFinished()) {
+        if (stopAfterMove >= 0 && static_cast<int>(out.moves.size()) >= stopAfterMove) break;
+        int shooter = rs.turn;
+        int before = rs.shotCount[shooter];
+        int sizesBefore[RulesT::SHIPS];
+        const int *sizes = (shooter == 0 ? rs.computerShipSizes : rs.playerShipSizes);
+        for (int i = 0; i < RulesT::SHIPS; ++i) sizesBefore[i] = sizes[i];
+
+        rs.tick();
+        if (rs.shotCount[shooter] == before) continue; // skipped shot
+
+        ReplayMove mv{};
+        mv.player = static_cast<uint8_t>(shooter);
+        mv.cell = rs.shotCells[shooter][before];
+        mv.result = -1;
+        for (int i = 0; i < RulesT::SHIPS; ++i) {
+            if (sizes[i] != sizesBefore[i]) {
+                mv.result = static_cast<int8_t>(i);
+                mv.sunk = sizes[i] == 0 ? 1 : 0;
+            }
+        }
+        out.moves.push_back(mv);
+    }
+
+    out.state = rs;
+    out.state.prior = nullptr;
+    out.shotsP1 = rs.playerStats.totalShots;
+    out.shotsP2 = rs.computerStats.totalShots;
+    if (rs.isFinished()) out.winner = rs.winnerP1() ? 0 : 1;
+    out.digest = moveDigest(out.moves);
+}
+
+uint64_t moveDigest(const std::vector<ReplayMove> &moves) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (const ReplayMove &mv : moves) {
+        h = (h ^ mv.player) * 0x100000001b3ULL;
+        h = (h ^ mv.cell) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+int firstDivergence(const std::vector<ReplayMove> &a, const std::vector<ReplayMove> &b) {
+    size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; ++i)
+        if (a[i].player != b[i].player || a[i].cell != b[i].cell) return static_cast<int>(i);
+    return a.size() == b.size() ? -1 : static_cast<int>(n);
+}
+
+#define INSTANTIATE_REPLAY(RulesT)                                                                       \
+    template void replayGame<RulesT>(uint64_t, long long, const AIWeights &, BasicReplayResult<RulesT> &, \
+                                     int, int, const BasicFleetLayout<RulesT> *, long long, bool);
+FOR_EACH_GAME_RULES(INSTANTIATE_REPLAY)
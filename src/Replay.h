@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Tournament.h"
+
+// Deterministic replay of single sweep games.
+//
+// Sweeps play games in fixed-size blocks: each block is one Tournament whose
+// learned prior starts fresh, and game g uses the seed gameSeed(masterSeed, g).
+// A game is therefore fully identified by (masterSeed, g, blockGames, weights)
+// and can be regenerated without replaying the rest of the sweep.
+
+// Default number of games per sweep block (one Tournament / prior lifetime)
+const int SWEEP_BLOCK_GAMES = 100;
+
+struct ReplayMove {
+    uint8_t player;   // 0 -> Player1, 1 -> Player2
+    uint8_t cell;     // row * cols + col
+    int8_t  result;   // -1 miss, otherwise index of the ship hit
+    uint8_t sunk;     // 1 if this shot sank the ship
+};
+
+template <class RulesT>
+struct BasicReplayResult {
+    typedef BasicFleetLayout<RulesT> Layout;
+    std::vector<ReplayMove> moves;
+    BasicRoundState<RulesT> state;  // round state after the last replayed move
+    int shotsP1 = 0;
+    int shotsP2 = 0;
+    int winner = -1;           // 0 / 1, or -1 if stopped before the end
+    uint64_t digest = 0;       // FNV-1a hash of the move sequence
+};
+typedef BasicReplayResult<StandardRules> ReplayResult;
+
+// Regenerate game `gameIndex` of a sweep with weights `w`. With `learnPrior`
+// (sweeps run with prior=1) earlier games of the same block are fast-forwarded to
+// rebuild the prior; otherwise the game is played on its own. If `stopAfterMove`
+// >= 0 the replay stops after that many moves of the target game. Sweeps played
+// on a layout corpus replay with the same layouts (see Tournament::layouts). The
+// rule set is the result's.
+template <class RulesT>
+void replayGame(uint64_t masterSeed, long long gameIndex, const AIWeights &w,
+                BasicReplayResult<RulesT> &out, int stopAfterMove = -1,
+                int blockGames = SWEEP_BLOCK_GAMES,
+                const typename BasicReplayResult<RulesT>::Layout *layouts = nullptr, long long layoutCount = 0,
+                bool learnPrior = false);
+
+// Digest of a move sequence (a few bytes that stand in for the full game log)
+uint64_t moveDigest(const std::vector<ReplayMove> &moves);
+
+// First index where the two sequences differ, or -1 if they are identical
+int firstDivergence(const std::vector<ReplayMove> &a, const std::vector<ReplayMove> &b);
@@ -0,0 +1,107 @@
+#include "ResultStore.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+
+// Entry file layout: EntryHeader followed by GameShots records in game order
+static const char ENTRY_MAGIC[4] = {'B', 'S', 'R', 'S'};
+static const uint32_t ENTRY_VERSION = 1;
+
+struct EntryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t seed;
+    int32_t blockGames;
+    int32_t pad;
+    double weights[AI_WEIGHT_COUNT];
+    char engine[40];
+};
+
+static void fillHeader(const ResultKey &key, EntryHeader &h) {
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, ENTRY_MAGIC, 4);
+    h.version = ENTRY_VERSION;
+    h.seed = key.seed;
+    h.blockGames = key.blockGames;
+    std::memcpy(h.weights, key.weights, sizeof(h.weights));
+    std::strncpy(h.engine, key.engine.c_str(), sizeof(h.engine) - 1);
+}
+
+uint64_t ResultKey::hash() const {
+    EntryHeader h;
+    fillHeader(*this, h);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(&h);
+    uint64_t x = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < sizeof(h); ++i) x = (x ^ p[i]) * 0x100000001b3ULL;
+    return x;
+}
+
+std::string ResultKey::hex() const {
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash();
+    return oss.str();
+}
+
+ResultKey makeResultKey(const AIWeights &w, uint64_t seed, int blockGames) {
+    ResultKey key;
+    weightsToArray(w, key.weights);
+    key.seed = seed;
+    key.blockGames = blockGames;
+    return key;
+}
+
+bool ResultStore::open(const std::string &path) {
+    dir = path;
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    return std::filesystem::is_directory(dir);
+}
+
+bool ResultStore::load(const ResultKey &key, std::vector<GameShots> &games) const {
+    games.clear();
+    std::string file = dir + "/" + key.hex() + ".bin";
+    FILE *f = fopen(file.c_str(), "rb");
+    if (!f) return true; // no entry yet
+
+    EntryHeader want, got;
+    fillHeader(key, want);
+    bool ok = fread(&got, sizeof(got), 1, f) == 1 && std::memcmp(&want, &got, sizeof(got)) == 0;
+    if (ok) {
+        GameShots g;
+        while (fread(&g, sizeof(g), 1, f) == 1) games.push_back(g);
+    }
+    fclose(f);
+    if (!ok) games.clear();
+    return ok;
+}
+
+bool ResultStore::append(const ResultKey &key, const std::vector<GameShots> &games, size_t from) const {
+    if (from >= games.size()) return true;
+    std::string file = dir + "/" + key.hex() + ".bin";
+    bool fresh = !std::filesystem::exists(file);
+    FILE *f = fopen(file.c_str(), "ab");
+    if (!f) return false;
+    bool ok = true;
+    if (fresh) {
+        EntryHeader h;
+        fillHeader(key, h);
+        ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    }
+    if (ok) ok = fwrite(games.data() + from, sizeof(GameShots), games.size() - from, f) == games.size() - from;
+    ok = (fclose(f) == 0) && ok;
+
+    // Index: one line per entry so the store can be browsed without decoding files
+    if (ok && fresh) {
+        FILE *idx = fopen((dir + "/index.csv").c_str(), "a");
+        if (idx) {
+            fprintf(idx, "%s,%s,%llu,%d", key.hex().c_str(), key.engine.c_str(),
+                    static_cast<unsigned long long>(key.seed), key.blockGames);
+            for (int i = 0; i < AI_WEIGHT_COUNT; ++i) fprintf(idx, ",%.17g", key.weights[i]);
+            fprintf(idx, "\n");
+            fclose(idx);
+        }
+    }
+    return ok;
+}
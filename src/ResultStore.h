@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MLforAI.h"
+
+// Content-addressed store of per-game sweep results.
+//
+// An entry is keyed by everything that determines a game's outcome: the full
+// weight vector, the sweep seed, the block size and the engine build. Games are
+// stored in index order, so an entry holding N games answers any request for
+// <= N games and is extended in place when more are asked for.
+
+// Identifies the engine build; build scripts pass a hash of the sources. The
+// tuner bypasses the cache in "dev" builds, which would key every version alike.
+#ifndef ENGINE_BUILD_HASH
+#define ENGINE_BUILD_HASH "dev"
+#endif
+
+struct GameShots {
+    uint16_t p1;
+    uint16_t p2;
+};
+
+struct ResultKey {
+    double weights[AI_WEIGHT_COUNT];
+    uint64_t seed = 0;
+    int32_t blockGames = 0;
+    std::string engine = ENGINE_BUILD_HASH;
+
+    uint64_t hash() const;
+    std::string hex() const;
+};
+
+ResultKey makeResultKey(const AIWeights &w, uint64_t seed, int blockGames);
+
+struct ResultStore {
+    std::string dir;
+
+    // Creates the directory (and index) if needed
+    bool open(const std::string &path);
+    // Loads every stored game of `key` into `games` (empty if absent)
+    bool load(const ResultKey &key, std::vector<GameShots> &games) const;
+    // Appends games[from..] to the entry of `key`, creating it if needed
+    bool append(const ResultKey &key, const std::vector<GameShots> &games, size_t from) const;
+};
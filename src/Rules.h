@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+// Board symbols of ships by index: the standard fleet's five first, then more for
+// larger fleets. None of them is a hit, miss, sunk or unknown marker.
+constexpr char FLEET_SYMBOLS[] = "cbrsdefghijk";
+
+// Bit (symbol - 'a') of every ship symbol, so testing a cell takes no loop
+constexpr uint32_t fleetSymbolMask() {
+    uint32_t mask = 0;
+    for (int i = 0; FLEET_SYMBOLS[i]; ++i) mask |= 1u << (FLEET_SYMBOLS[i] - 'a');
+    return mask;
+}
+constexpr uint32_t FLEET_SYMBOL_MASK = fleetSymbolMask();
+
+// Board geometry and fleet as a type. The game engine (boards, move scoring,
+// RoundState and Tournament, the batch lanes, replays) and the probability
+// kernels (RulesKernels.h, the CUDA sampler) are templates on a Rules type, so
+// every variant is compiled fully specialized: loop bounds, array sizes and the
+// line-mask width are compile-time constants. NUM_ROWS, NUM_COLS and SHIP_SIZES
+// in battleship.h are StandardRules' values, and the unqualified engine names
+// (RoundState, chooseAIMove, ...) are its instances.
+template <int R, int C, int... Sizes>
+struct Rules {
+    static constexpr int ROWS = R;
+    static constexpr int COLS = C;
+    static constexpr int CELLS = R * C;
+    static constexpr int SHIPS = sizeof...(Sizes);
+    static constexpr int LINE = R > C ? R : C;      // longest row or column
+    static constexpr int SIZES[SHIPS] = {Sizes...};
+    static constexpr int FLEET_CELLS = (0 + ... + Sizes);
+
+    static_assert(R > 0 && C > 0 && SHIPS > 0, "a board needs cells and ships");
+    static_assert(LINE <= 32, "rows and columns are held in 32-bit masks at most");
+    static_assert(((Sizes > 0 && Sizes <= LINE) && ...), "every ship must fit in a line");
+    static_assert(SHIPS < int(sizeof(FLEET_SYMBOLS)), "not enough ship symbols");
+
+    static constexpr char symbol(int ship) { return FLEET_SYMBOLS[ship]; }
+    static constexpr int longestShip() {
+        int longest = 0;
+        for (int i = 0; i < SHIPS; ++i) longest = SIZES[i] > longest ? SIZES[i] : longest;
+        return longest;
+    }
+
+    // One bit per cell of a row or column
+    typedef typename std::conditional<(LINE <= 16), uint16_t, uint32_t>::type LineMask;
+};
+
+typedef Rules<10, 10, 5, 4, 3, 3, 2> StandardRules;
+
+// Variants the game engine is built for, besides StandardRules
+typedef Rules<8, 8, 4, 3, 3, 2> Rules8x8;                   // training board, no carrier
+typedef Rules<12, 12, 5, 4, 3, 3, 2> Rules12x12;
+typedef Rules<15, 15, 6, 5, 4, 4, 3, 3, 2> Rules15x15;      // larger fleet
+
+// Applies X to every rule set the engine is built for; each engine source file
+// instantiates its templates with it
+#define FOR_EACH_GAME_RULES(X) X(StandardRules) X(Rules8x8) X(Rules12x12) X(Rules15x15)
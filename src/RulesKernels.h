@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include "Rules.h"
+#include "battleship.h"     // HIT, MISS, SUNK, isShipSymbol, GameRng
+#include "simd_kernels.h"
+
+// Probability kernels templated on a Rules type. Each works on row and column
+// bitmasks of RulesT::LineMask, with every bound known at compile time;
+// placementCounts builds its masks with the SIMD row compares of boardMasks. The
+// engine's computePlacementProbabilities and Monte Carlo sampler call the
+// instance of their own rule set; `tuner scaling` also times rule sets the
+// engine is not built for.
+
+// Adds, per cell, the weight of every placement of each remaining ship that
+// covers it. Misses and resolved sunk cells block a placement; each hit it
+// covers raises its weight by hitMultiplier. Counts of cells that are not
+// unknown ('-') are zero.
+template <class RulesT>
+void placementCounts(const char view[RulesT::ROWS][RulesT::COLS], const int remaining[RulesT::SHIPS],
+                     double hitMultiplier, int counts[RulesT::ROWS][RulesT::COLS]) {
+    typedef typename RulesT::LineMask Mask;
+    const int R = RulesT::ROWS, C = RulesT::COLS;
+    Mask blockRows[R], blockCols[C], sunkRows[R], sunkCols[C], hitRows[R], hitCols[C];
+    boardMasks<RulesT>(view, MISS, blockRows, blockCols);
+    boardMasks<RulesT>(view, SUNK, sunkRows, sunkCols);
+    boardMasks<RulesT>(view, HIT, hitRows, hitCols);
+    for (int r = 0; r < R; ++r) blockRows[r] |= sunkRows[r];
+    for (int c = 0; c < C; ++c) blockCols[c] |= sunkCols[c];
+
+    int hitWeight[RulesT::LINE + 1];
+    for (int k = 0; k <= RulesT::LINE; ++k) hitWeight[k] = static_cast<int>(1.0 + hitMultiplier * k);
+
+    // Each placement adds its weight over its span through a difference array
+    int rowDiff[R][C + 1] = {}, colDiff[C][R + 1] = {};
+    for (int i = 0; i < RulesT::SHIPS; ++i) {
+        const int len = remaining[i];
+        if (len <= 0) continue;
+        const Mask span = static_cast<Mask>((uint64_t(1) << len) - 1);
+        for (int r = 0; r < R; ++r)
+            for (int c = 0; c + len <= C; ++c) {
+                if ((blockRows[r] >> c) & span) continue;
+                int w = hitWeight[__builtin_popcount(static_cast<unsigned>((hitRows[r] >> c) & span))];
+                rowDiff[r][c] += w;
+                rowDiff[r][c + len] -= w;
+            }
+        for (int c = 0; c < C; ++c)
+            for (int r = 0; r + len <= R; ++r) {
+                if ((blockCols[c] >> r) & span) continue;
+                int w = hitWeight[__builtin_popcount(static_cast<unsigned>((hitCols[c] >> r) & span))];
+                colDiff[c][r] += w;
+                colDiff[c][r + len] -= w;
+            }
+    }
+
+    for (int r = 0; r < R; ++r) {
+        int run = 0;
+        for (int c = 0; c < C; ++c) { run += rowDiff[r][c]; counts[r][c] = run; }
+    }
+    for (int c = 0; c < C; ++c) {
+        int run = 0;
+        for (int r = 0; r < R; ++r) { run += colDiff[c][r]; counts[r][c] += run; }
+    }
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+            if (view[r][c] != '-') counts[r][c] = 0;
+}
+
+// Adds the cells covered by `iterations` random fleets of ships[0..nShips) that
+// are consistent with the view. Each ship gets up to 200 uniform (orientation,
+// row, column) draws from `rng`; samples where one does not fit are dropped.
+// Ships may cross hits, unknown cells and hidden ship symbols but not each other.
+template <class RulesT>
+void monteCarloCounts(const char view[RulesT::ROWS][RulesT::COLS], const int ships[], int nShips, int iterations,
+                      GameRng &rng, int counts[RulesT::ROWS][RulesT::COLS]) {
+    typedef typename RulesT::LineMask Mask;
+    const int R = RulesT::ROWS, C = RulesT::COLS;
+    Mask blockRows[R] = {}, blockCols[C] = {};
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c) {
+            const char ch = view[r][c];
+            if (ch != '-' && ch != HIT && !isShipSymbol(ch)) {
+                blockRows[r] |= static_cast<Mask>(Mask(1) << c);
+                blockCols[c] |= static_cast<Mask>(Mask(1) << r);
+            }
+        }
+
+    for (int it = 0; it < iterations; ++it) {
+        Mask rows[R] = {}, cols[C] = {};
+        bool ok = true;
+        for (int s = 0; s < nShips && ok; ++s) {
+            const int len = ships[s];
+            const Mask span = static_cast<Mask>((uint64_t(1) << len) - 1);
+            bool placed = false;
+            for (int attempt = 0; attempt < 200 && !placed; ++attempt) {
+                bool horiz = rng.below(2);
+                int r = rng.below(R);
+                int c = rng.below(C);
+                if (horiz) {
+                    if (c + len > C || ((blockRows[r] | rows[r]) >> c) & span) continue;
+                    rows[r] |= static_cast<Mask>(span << c);
+                    for (int k = 0; k < len; ++k) cols[c + k] |= static_cast<Mask>(Mask(1) << r);
+                } else {
+                    if (r + len > R || ((blockCols[c] | cols[c]) >> r) & span) continue;
+                    cols[c] |= static_cast<Mask>(span << r);
+                    for (int k = 0; k < len; ++k) rows[r + k] |= static_cast<Mask>(Mask(1) << c);
+                }
+                placed = true;
+            }
+            ok = placed;
+        }
+        if (!ok) continue;
+        for (int r = 0; r < R; ++r)
+            for (unsigned m = rows[r]; m; m &= m - 1) counts[r][__builtin_ctz(m)]++;
+    }
+}
@@ -1,19 +1,107 @@
 #include "Tournament.h"
-#include <sstream>
-#include <iomanip>
+#include "Metrics.h"
+#include <cstdio>
 #include <cstring>
+#include <cmath>
+#include <tuple>
+
+// One set of snapshot buffers per rule set
+template <class RulesT> static float BOARD_BUFFER[RulesT::CELLS]; // reused for snapshots
+template <class RulesT> static float HEATMAP_BUFFER[RulesT::CELLS]; // reused for heatmap snapshots
+template <class RulesT> static float BOARD1_BUFFER[RulesT::CELLS]; // Player 1's board
+template <class RulesT> static float BOARD2_BUFFER[RulesT::CELLS]; // Player 2's board
+template <class RulesT> static float HEAT1_BUFFER[RulesT::CELLS];  // Player 1's heatmap
+template <class RulesT> static float HEAT2_BUFFER[RulesT::CELLS];  // Player 2's heatmap
+
+// Placement map of a blank view. It does not depend on the AI weights (no hits to
+// multiply), so every round can share one copy instead of re-enumerating.
+template <class RulesT>
+struct BlankPlacementMap {
+    double p[RulesT::ROWS][RulesT::COLS];
+    BlankPlacementMap() {
+        char view[RulesT::ROWS][RulesT::COLS];
+        initializeBoard<RulesT>(view);
+        computePlacementProbabilities<RulesT>(view, RulesT::SIZES, p);
+    }
+};
+
+template <class RulesT>
+static const BlankPlacementMap<RulesT> &blankPlacementMap() {
+    static const BlankPlacementMap<RulesT> map;
+    return map;
+}
+
+template <class RulesT>
+void BasicPlacementPrior<RulesT>::reset() {
+    const BlankPlacementMap<RulesT> &base = blankPlacementMap<RulesT>();
+    int shipCells = 0;
+    for (int i = 0; i < RulesT::SHIPS; ++i) shipCells += RulesT::SIZES[i];
+    double baseMean = 0.0;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) baseMean += base.p[r][c];
+    baseMean /= (RulesT::CELLS);
+    gain = baseMean / (double(shipCells) / (RulesT::CELLS));
+
+    std::memset(hits, 0, sizeof(hits));
+    std::memset(shots, 0, sizeof(shots));
+    scale = 1.0;
+    rounds = 0;
+}
+
+template <class RulesT>
+void BasicPlacementPrior<RulesT>::observeRound(const BasicRoundState<RulesT> &rs) {
+    ++rounds;
+    // Ageing every older observation by `decay` is the same as weighing this
+    // round's by 1/decay more; rescale the board only when the weight gets large
+    scale /= decay;
+    if (scale > 1e100) {
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c) {
+                hits[r][c] /= scale;
+                shots[r][c] /= scale;
+            }
+        scale = 1.0;
+    }
+    for (int s = 0; s < 2; ++s) {
+        const char (*target)[RulesT::COLS] = (s == 0 ? rs.computerBoard : rs.playerBoard);
+        for (int i = 0; i < rs.shotCount[s]; ++i) {
+            int r = rs.shotCells[s][i] / RulesT::COLS;
+            int c = rs.shotCells[s][i] % RulesT::COLS;
+            shots[r][c] += scale;
+            if (target[r][c] == HIT) hits[r][c] += scale;
+        }
+    }
+}
 
-static float BOARD_BUFFER[100]; // reused for snapshots
-static float HEATMAP_BUFFER[100]; // reused for heatmap snapshots
-static float BOARD1_BUFFER[100]; // Player 1's board
-static float BOARD2_BUFFER[100]; // Player 2's board
-static float HEAT1_BUFFER[100];  // Player 1's heatmap
-static float HEAT2_BUFFER[100];  // Player 2's heatmap
+template <class RulesT>
+void BasicPlacementPrior<RulesT>::read(double out[RulesT::ROWS][RulesT::COLS]) const {
+    const BlankPlacementMap<RulesT> &base = blankPlacementMap<RulesT>();
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            out[r][c] = (gain * hits[r][c] / scale + strength * base.p[r][c]) / (shots[r][c] / scale + strength);
+}
 
-void RoundState::reset(int mode_, int round_) {
+// Shot of a player's distilled policy; false when the player has none. Policies are
+// trained on the standard board, so other rule sets never use one.
+template <class RulesT>
+static bool policyMove(const PolicyModel *m, const char board[RulesT::ROWS][RulesT::COLS], const int remaining[],
+                       int &row, int &col) {
+    if constexpr (std::is_same<RulesT, StandardRules>::value) {
+        if (m) {
+            std::tie(row, col) = chooseAIMovePolicy(*m, board, remaining);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class RulesT>
+void BasicRoundState<RulesT>::reset(int mode_, int round_) {
+    GameRngScope useRng(rng);
+    AIWeightsScope useWeights(weights);
     mode = mode_;
     roundIndex = round_;
-    lastLog.clear();
+    lastLog[0] = '\0';
 
     // Player types
     PlayerType player1Type, player2Type;
@@ -22,17 +110,19 @@ void RoundState::reset(int mode_, int round_) {
     else { player1Type = COMPUTER; player2Type = COMPUTER; }
 
     // Boards
-    initializeBoard(playerBoard);
-    initializeBoard(computerBoard);
+    initializeBoard<RulesT>(playerBoard);
+    initializeBoard<RulesT>(computerBoard);
 
-    // Placement
-    biasedPlaceShipsOnBoard(playerBoard);
-    biasedPlaceShipsOnBoard(computerBoard);
+    // Placement (a recorded layout that does not fit falls back to sampling)
+    if (!fleets || !fleetSampler<RulesT>(FLEET_CENTER).place(playerBoard, fleets[0]))
+        biasedPlaceShipsOnBoard<RulesT>(playerBoard);
+    if (!fleets || !fleetSampler<RulesT>(FLEET_CENTER).place(computerBoard, fleets[1]))
+        biasedPlaceShipsOnBoard<RulesT>(computerBoard);
 
     // Ship health
-    for (int i = 0; i < NUM_SHIPS; ++i) {
-        playerShipSizes[i] = SHIP_SIZES[i];
-        computerShipSizes[i] = SHIP_SIZES[i];
+    for (int i = 0; i < RulesT::SHIPS; ++i) {
+        playerShipSizes[i] = RulesT::SIZES[i];
+        computerShipSizes[i] = RulesT::SIZES[i];
     }
 
     // Stats reset
@@ -40,111 +130,171 @@ void RoundState::reset(int mode_, int round_) {
     computerStats = Stats{};
 
     // Learning arrays reset
-    std::memset(hitCount, 0, sizeof(hitCount));
-    std::memset(missCount, 0, sizeof(missCount));
-    std::memset(liveHitsP1, 0, sizeof(liveHitsP1));
-    std::memset(liveMissesP1, 0, sizeof(liveMissesP1));
-    std::memset(liveHitsP2, 0, sizeof(liveHitsP2));
-    std::memset(liveMissesP2, 0, sizeof(liveMissesP2));
-    std::memset(hitProb, 0, sizeof(hitProb));
+    for (int p = 0; p < 2; ++p) {
+        liveHits[p].clear();
+        liveMisses[p].clear();
+        sunkShips[p].clear();
+    }
     std::memset(liveProbP1, 0, sizeof(liveProbP1));
     std::memset(liveProbP2, 0, sizeof(liveProbP2));
 
-    // Learn from prior log if available (native runs only; in browser omit file I/O)
-    // learnFromLog("battleship.log", hitCount, missCount);
-
-    // Initialize global hit probability using placement enumeration on a blank view
-    char initialView[NUM_ROWS][NUM_COLS];
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
-            initialView[r][c] = '-';
-    computePlacementProbabilities(initialView, computerShipSizes, hitProb);
+    // Global hit probability: the tournament's learned prior when one is attached,
+    // otherwise the (cached) placement enumeration of a blank view
+    if (prior) prior->read(hitProb);
+    else std::memcpy(hitProb, blankPlacementMap<RulesT>().p, sizeof(hitProb));
+    shotCount[0] = shotCount[1] = 0;
+    tierCounts[0] = tierCounts[1] = tierCounts[2] = 0;
 
     // Who starts
     turn = selectWhoStartsFirst();
     gameOver = false;
     turnCount = 0;
+    publishAll();
 
-    p1Target = TargetState{};
-    p2Target = TargetState{};
+    p1Target = BasicTargetState<RulesT>{};
+    p2Target = BasicTargetState<RulesT>{};
 }
 
-const char* RoundState::tick() {
-    if (gameOver) { lastLog = "[Round already finished]"; return lastLog.c_str(); }
-
-    PlayerType player1Type = (mode == 1 ? HUMAN : (mode == 2 ? HUMAN : COMPUTER));
-    PlayerType player2Type = (mode == 1 ? HUMAN : COMPUTER);
-
-    PlayerType currentType = (turn == 0 ? player1Type : player2Type);
-    char (*targetBoard)[NUM_COLS] = (turn == 0 ? computerBoard : playerBoard);
-    int *targetShipSizes = (turn == 0 ? computerShipSizes : playerShipSizes);
-    Stats &currentStats = (turn == 0 ? playerStats : computerStats);
-    std::string currentName = (turn == 0 ? "Player1" : "Player2");
-
+template <class RulesT>
+const char* BasicRoundState<RulesT>::tick() {
+    ProfileScope profile(PROFILE_TICK);
+    AIWeightsScope useWeights(weights);
     int row = -1, col = -1;
-    if (currentType == HUMAN) {
-        // In browser, we don’t block for input; leave a message and skip
-        lastLog = "[Human move requested; demo runs AI only]";
-        // You can later expose feedLine() and parse commands if you want interactive play
-        currentType = COMPUTER;
-    }
+    if (!gameOver) {
+        GameRngScope useRng(rng);
+        PlayerType player1Type = (mode == 1 ? HUMAN : (mode == 2 ? HUMAN : COMPUTER));
+        PlayerType player2Type = (mode == 1 ? HUMAN : COMPUTER);
+        PlayerType currentType = (turn == 0 ? player1Type : player2Type);
+        if (currentType == HUMAN) {
+            // In browser, we don’t block for input; leave a message and skip
+            setLog("[Human move requested; demo runs AI only]");
+            // You can later expose feedLine() and parse commands if you want interactive play
+            currentType = COMPUTER;
+        }
 
-    if (currentType == COMPUTER) {
-        TargetState &ts = (turn == 0 ? p1Target : p2Target);
+        EngineMetrics *metrics = engineMetrics();
+        HistogramTimer timeMove(metrics ? &metrics->moveLatencyNs : nullptr);
+        BasicTargetState<RulesT> &ts = (turn == 0 ? p1Target : p2Target);
+        int *targetShipSizes = (turn == 0 ? computerShipSizes : playerShipSizes);
         // Choose which liveProb to use depending on which player is choosing
-        double (*livePtr)[NUM_COLS] = (turn == 0) ? liveProbP1 : liveProbP2;
-        std::tie(row, col) = chooseAIMove(targetBoard, hitProb, livePtr, ts, targetShipSizes, turnCount);
-        if (!checkShotIsAvailable(targetBoard, row, col)) {
-            ts.active = false; ts.oriented = false; ts.orientation = 0; ts.queue.clear();
-            std::tie(row, col) = getSmartMove(targetBoard, hitProb);
+        double (*livePtr)[RulesT::COLS] = (turn == 0) ? liveProbP1 : liveProbP2;
+        char board[RulesT::ROWS][RulesT::COLS];
+        aiBoard(turn, board);
+        if (policyMove<RulesT>(policy[turn], board, targetShipSizes, row, col)) {
+            // the distilled policy picked the shot
+        } else if (moveBudgetMs >= 0.0) {
+            std::tie(row, col) = chooseAIMoveWithin<RulesT>(board, hitProb, livePtr, ts, targetShipSizes,
+                                                    turnCount, moveBudgetMs, &lastTier);
+            tierCounts[lastTier]++;
+        } else {
+            std::tie(row, col) = chooseAIMove<RulesT>(board, hitProb, livePtr, ts, targetShipSizes, turnCount);
         }
     }
+    return fire(row, col);
+}
+
+template <class RulesT>
+const char* BasicRoundState<RulesT>::fire(int row, int col) {
+    AIWeightsScope useWeights(weights);
+    lastEvent = TickEvent{};
+    lastEvent.player = static_cast<uint8_t>(turn);
+    lastEvent.flags = TICK_SKIPPED;
+    lastEvent.ship = -1;
+    lastEvent.round = static_cast<uint16_t>(roundIndex);
+    if (gameOver) { setLog("[Round already finished]"); return lastLog; }
+    GameRngScope useRng(rng);
+
+    char (*targetBoard)[RulesT::COLS] = (turn == 0 ? computerBoard : playerBoard);
+    int *targetShipSizes = (turn == 0 ? computerShipSizes : playerShipSizes);
+    Stats &currentStats = (turn == 0 ? playerStats : computerStats);
+    const char *currentName = (turn == 0 ? "Player1" : "Player2");
+    BasicTargetState<RulesT> &ts = (turn == 0 ? p1Target : p2Target);
+
+    if (!checkShotIsAvailable<RulesT>(targetBoard, row, col)) {
+        char board[RulesT::ROWS][RulesT::COLS];
+        aiBoard(turn, board);
+        ts.active = false; ts.oriented = false; ts.orientation = 0; ts.queue.clear();
+        std::tie(row, col) = getSmartMove<RulesT>(board, hitProb);
+    }
 
-    if (!checkShotIsAvailable(targetBoard, row, col)) {
+    if (!checkShotIsAvailable<RulesT>(targetBoard, row, col)) {
         // skip if invalid
         turn = 1 - turn;
-        lastLog = "[Skipped invalid shot]";
-        return lastLog.c_str();
+        setLog("[Skipped invalid shot]");
+        return lastLog;
     }
 
-    int res = updateBoard(targetBoard, row, col, targetShipSizes);
+    int res = updateBoard<RulesT>(targetBoard, row, col, targetShipSizes);
+    shotCells[turn][shotCount[turn]++] = static_cast<uint8_t>(row * RulesT::COLS + col);
     bool sunk = false;
+    lastEvent.cell = static_cast<uint8_t>(row * RulesT::COLS + col);
+    lastEvent.flags = 0;
     if (res != -1) {
-        sunk = updateShipSize(targetShipSizes, res);
+        sunk = updateShipSize<RulesT>(targetShipSizes, res);
+        lastEvent.ship = static_cast<int8_t>(res);
+        lastEvent.flags = TICK_HIT | (sunk ? TICK_SUNK : 0);
         currentStats.hits++;
         // record observation for the shooter: if turn==0, Player1 observed this hit on Player2
-        if (turn == 0) liveHitsP1[row][col]++;
-        else liveHitsP2[row][col]++;
+        liveHits[turn].set(row * RulesT::COLS + col);
+        if (sunk) sunkShips[turn].add(liveHits[turn], row, col, RulesT::SIZES[res]);
     } else {
         currentStats.misses++;
-        if (turn == 0) liveMissesP1[row][col]++;
-        else liveMissesP2[row][col]++;
+        liveMisses[turn].set(row * RulesT::COLS + col);
     }
     currentStats.totalShots++;
     currentStats.hitMissRatio = currentStats.totalShots ?
         (100.0 * currentStats.hits / currentStats.totalShots) : 0.0;
 
-    // Update both players' heatmaps from their own observations
-    // Player1 observes the computer board; Player2 observes the player board.
-    char viewP1[NUM_ROWS][NUM_COLS];
-    char viewP2[NUM_ROWS][NUM_COLS];
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
-            viewP1[r][c] = (liveHitsP1[r][c] > 0) ? 'X' : (liveMissesP1[r][c] > 0 ? 'm' : '-');
-            viewP2[r][c] = (liveHitsP2[r][c] > 0) ? 'X' : (liveMissesP2[r][c] > 0 ? 'm' : '-');
+    // Renderers read both players' live maps; the next move rebuilds its own first
+    if (liveMaps) refreshLiveMaps();
+
+    publishShot(turn, row, col, res != -1);
+
+    // Log message
+    if (logMoves) {
+        std::snprintf(lastLog, sizeof(lastLog), "%s fires (%d,%d) -> %s", currentName, row, col,
+                      res == -1 ? "miss" : sunk ? "HIT + SUNK" : "HIT");
+    }
+
+    char board[RulesT::ROWS][RulesT::COLS];
+    aiBoard(turn, board);
+    updateTargetStateAfterResult<RulesT>(ts, board, row, col, res, sunk, targetShipSizes);
+
+    if (isWinner<RulesT>(targetShipSizes)) {
+        gameOver = true;
+        currentStats.won = true;
+        (turn == 0 ? computerStats : playerStats).won = false;
+        if (logMoves) {
+            std::snprintf(lastLog, sizeof(lastLog), "%s wins round %d!", currentName, roundIndex);
         }
+        return lastLog;
     }
+
+    turnCount++;
+    turn = 1 - turn;
+    return lastLog;
+}
+
+// Update both players' heatmaps from their own observations
+template <class RulesT>
+void BasicRoundState<RulesT>::refreshLiveMaps() {
+    int *targetShipSizes = (turn == 0 ? computerShipSizes : playerShipSizes);
+    // Player1 observes the computer board; Player2 observes the player board.
+    char viewP1[RulesT::ROWS][RulesT::COLS];
+    char viewP2[RulesT::ROWS][RulesT::COLS];
+    observedView(0, viewP1);
+    observedView(1, viewP2);
     // Player1's probabilities target the computer's ships
-    computePlacementProbabilities(viewP1, computerShipSizes, liveProbP1);
+    computePlacementProbabilities<RulesT>(viewP1, computerShipSizes, liveProbP1);
     // Player2's probabilities target the player's ships
-    computePlacementProbabilities(viewP2, playerShipSizes, liveProbP2);
-    
+    computePlacementProbabilities<RulesT>(viewP2, playerShipSizes, liveProbP2);
+
     // For MC blending, use the current shooter's view and remaining cells
-    char view[NUM_ROWS][NUM_COLS];
+    char view[RulesT::ROWS][RulesT::COLS];
     int remainingCells = 0;
-    for (int i = 0; i < NUM_SHIPS; ++i) remainingCells += targetShipSizes[i];
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    for (int i = 0; i < RulesT::SHIPS; ++i) remainingCells += targetShipSizes[i];
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             if (turn == 0) {
                 view[r][c] = viewP1[r][c];
             } else {
@@ -152,215 +302,305 @@ const char* RoundState::tick() {
             }
         }
     }
-    // Endgame Monte-Carlo blend when few ship cells remain
-    if (remainingCells <= gAIWeights.mcBlendThresholdCells) {
-        double mcMap[NUM_ROWS][NUM_COLS];
-        monteCarloProbabilities(view, targetShipSizes, gAIWeights.mcIterations, mcMap);
-        for (int r = 0; r < NUM_ROWS; ++r)
-            for (int c = 0; c < NUM_COLS; ++c) {
-                if (turn == 0) liveProbP1[r][c] = (1.0 - gAIWeights.mcBlendRatio) * liveProbP1[r][c] + gAIWeights.mcBlendRatio * mcMap[r][c];
-                else liveProbP2[r][c] = (1.0 - gAIWeights.mcBlendRatio) * liveProbP2[r][c] + gAIWeights.mcBlendRatio * mcMap[r][c];
+    // Endgame Monte-Carlo blend when few ship cells remain, for renderers (moves
+    // sample their own inside chooseAIMove; budgeted rounds skip it to save time)
+    const AIWeights &W = aiWeights();
+    if (remainingCells <= W.mcBlendThresholdCells && moveBudgetMs < 0.0) {
+        double mcMap[RulesT::ROWS][RulesT::COLS];
+        monteCarloProbabilities<RulesT>(view, targetShipSizes, W.mcIterations, mcMap);
+        for (int r = 0; r < RulesT::ROWS; ++r)
+            for (int c = 0; c < RulesT::COLS; ++c) {
+                if (turn == 0) liveProbP1[r][c] = (1.0 - W.mcBlendRatio) * liveProbP1[r][c] + W.mcBlendRatio * mcMap[r][c];
+                else liveProbP2[r][c] = (1.0 - W.mcBlendRatio) * liveProbP2[r][c] + W.mcBlendRatio * mcMap[r][c];
             }
     }
+}
 
-    // Log message
-    {
-        std::ostringstream oss;
-        oss << currentName << " fires (" << row << "," << col << ")";
-        if (res != -1) oss << " -> HIT" << (sunk ? " + SUNK" : "");
-        else oss << " -> miss";
-        lastLog = oss.str();
-    }
-
-    if (currentType == COMPUTER) {
-        TargetState &ts = (turn == 0 ? p1Target : p2Target);
-        updateTargetStateAfterResult(ts, targetBoard, row, col, res, sunk, targetShipSizes);
-    }
+template <class RulesT>
+void BasicRoundState<RulesT>::setLog(const char *msg) {
+    std::snprintf(lastLog, sizeof(lastLog), "%s", msg);
+}
 
-    if (isWinner(targetShipSizes)) {
-        gameOver = true;
-        currentStats.won = true;
-        (turn == 0 ? computerStats : playerStats).won = false;
-        std::ostringstream oss;
-        oss << (turn == 0 ? "Player1" : "Player2") << " wins round " << roundIndex << "!";
-        lastLog = oss.str();
-        return lastLog.c_str();
-    }
+template <class RulesT>
+void BasicRoundState<RulesT>::observedView(int shooter, char view[RulesT::ROWS][RulesT::COLS]) const {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            int cell = r * RulesT::COLS + c;
+            view[r][c] = liveHits[shooter].test(cell) ? 'X' : (liveMisses[shooter].test(cell) ? 'm' : '-');
+        }
+    sunkShips[shooter].overlay(view);
+}
 
-    turnCount++;
-    turn = 1 - turn;
-    return lastLog.c_str();
+template <class RulesT>
+void BasicRoundState<RulesT>::aiBoard(int shooter, char board[RulesT::ROWS][RulesT::COLS]) const {
+    std::memcpy(board, shooter == 0 ? computerBoard : playerBoard, RulesT::CELLS);
+    sunkShips[shooter].overlay(board);
 }
 
-const float* RoundState::snapshotBoard(bool showComputerBoard) {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::snapshotBoard(bool showComputerBoard) {
     // For demo, show the computer’s board perspective (hits/misses inflicted)
-    const char (*b)[NUM_COLS] = showComputerBoard ? computerBoard : playerBoard;
+    const char (*b)[RulesT::COLS] = showComputerBoard ? computerBoard : playerBoard;
     // Map chars to floats: empty 0, miss -1, hit 1
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             float v = 0.0f;
             if (b[r][c] == MISS) v = -1.0f;
             else if (b[r][c] == HIT) v = 1.0f;
             // leave ships/unknown as 0 for clean visualization
-            BOARD_BUFFER[r * NUM_COLS + c] = v;
+            BOARD_BUFFER<RulesT>[r * RulesT::COLS + c] = v;
         }
     }
-    return BOARD_BUFFER;
+    return BOARD_BUFFER<RulesT>;
 }
 
-const float* RoundState::getHeatmapSnapshot() {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::getHeatmapSnapshot() {
     // Return the live probability heatmap (0.0-1.0)
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             // Provide the 'global' liveProb for debugging - average of both players' maps
             double val = 0.0;
             val = 0.5 * (liveProbP1[r][c] + liveProbP2[r][c]);
-            HEATMAP_BUFFER[r * NUM_COLS + c] = static_cast<float>(val);
+            HEATMAP_BUFFER<RulesT>[r * RulesT::COLS + c] = static_cast<float>(val);
         }
     }
-    return HEATMAP_BUFFER;
+    return HEATMAP_BUFFER<RulesT>;
 }
 
-const float* RoundState::snapshotPlayer1Board() {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::snapshotPlayer1Board() {
     // Player 1's board (what Player 2 is attacking)
-    const char (*b)[NUM_COLS] = playerBoard;
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    const char (*b)[RulesT::COLS] = playerBoard;
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             float v = 0.0f;
             if (b[r][c] == MISS) v = -1.0f;
             else if (b[r][c] == HIT) v = 1.0f;
-            BOARD1_BUFFER[r * NUM_COLS + c] = v;
+            BOARD1_BUFFER<RulesT>[r * RulesT::COLS + c] = v;
         }
     }
-    return BOARD1_BUFFER;
+    return BOARD1_BUFFER<RulesT>;
 }
 
-const float* RoundState::snapshotPlayer2Board() {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::snapshotPlayer2Board() {
     // Player 2's board (what Player 1 is attacking)
-    const char (*b)[NUM_COLS] = computerBoard;
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
+    const char (*b)[RulesT::COLS] = computerBoard;
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
             float v = 0.0f;
             if (b[r][c] == MISS) v = -1.0f;
             else if (b[r][c] == HIT) v = 1.0f;
-            BOARD2_BUFFER[r * NUM_COLS + c] = v;
+            BOARD2_BUFFER<RulesT>[r * RulesT::COLS + c] = v;
         }
     }
-    return BOARD2_BUFFER;
+    return BOARD2_BUFFER<RulesT>;
 }
 
-const float* RoundState::getPlayer1Heatmap() {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::getPlayer1Heatmap() {
     // P1's targeting heatmap
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
-            HEAT1_BUFFER[r * NUM_COLS + c] = static_cast<float>(liveProbP1[r][c]);
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            HEAT1_BUFFER<RulesT>[r * RulesT::COLS + c] = static_cast<float>(liveProbP1[r][c]);
         }
     }
-    return HEAT1_BUFFER;
+    return HEAT1_BUFFER<RulesT>;
 }
 
-const float* RoundState::getPlayer2Heatmap() {
+template <class RulesT>
+const float* BasicRoundState<RulesT>::getPlayer2Heatmap() {
     // P2's targeting heatmap
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
-            HEAT2_BUFFER[r * NUM_COLS + c] = static_cast<float>(liveProbP2[r][c]);
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            HEAT2_BUFFER<RulesT>[r * RulesT::COLS + c] = static_cast<float>(liveProbP2[r][c]);
         }
     }
-    return HEAT2_BUFFER;
+    return HEAT2_BUFFER<RulesT>;
+}
+
+template <class RulesT>
+void BasicRoundState<RulesT>::publishHeat() {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            shared->heat[0][r * RulesT::COLS + c] = static_cast<float>(liveProbP1[r][c]);
+            shared->heat[1][r * RulesT::COLS + c] = static_cast<float>(liveProbP2[r][c]);
+        }
+}
+
+template <class RulesT>
+void BasicRoundState<RulesT>::publishAll() {
+    if (!shared) return;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            shared->board[0][r * RulesT::COLS + c] = playerBoard[r][c] == HIT ? 1 : (playerBoard[r][c] == MISS ? -1 : 0);
+            shared->board[1][r * RulesT::COLS + c] = computerBoard[r][c] == HIT ? 1 : (computerBoard[r][c] == MISS ? -1 : 0);
+        }
+    publishHeat();
+    shared->round = static_cast<uint32_t>(roundIndex);
+    shared->generation++;
 }
 
-void Tournament::start(int mode, int n) {
+// The shooter fires at the other player's board; only that cell changes
+template <class RulesT>
+void BasicRoundState<RulesT>::publishShot(int shooter, int row, int col, bool hit) {
+    if (!shared) return;
+    shared->board[1 - shooter][row * RulesT::COLS + col] = hit ? 1 : -1;
+    publishHeat();
+    shared->generation++;
+}
+
+template <class RulesT>
+void BasicTournament<RulesT>::start(int mode, int n, uint64_t seed_, long long firstGame_) {
     totalRounds = n;
+    seed = seed_;
+    firstGame = firstGame_;
     currentRoundIdx = 0;
     p1WinsAccum = p2WinsAccum = 0;
-    shotsP1Accum = shotsP1Accum = 0;
-    shotsP2Accum = shotsP2Accum = 0;
-    current.reset(mode, 1);
+    shotsP1Accum = 0;
+    shotsP2Accum = 0;
+    tierAccum[0] = tierAccum[1] = tierAccum[2] = 0;
+    prior.reset();
+    current.prior = learnPrior ? &prior : nullptr;
+    current.shared = shared;
+    current.weights = weights;
+    current.policy[0] = policy[0];
+    current.policy[1] = policy[1];
+    current.mode = mode;
+    beginRound(0);
 }
 
-const char* Tournament::tick() {
-    if (currentRoundIdx >= totalRounds && current.isFinished()) {
-        static std::string doneMsg = "[Tournament finished]";
-        return doneMsg.c_str();
-    }
+template <class RulesT>
+void BasicTournament<RulesT>::beginRound(int roundIdx) {
+    long long game = firstGame + roundIdx;
+    current.rng.seed(gameSeed(seed, game));
+    long long pairs = layouts ? layoutCount / 2 : 0;
+    current.fleets = pairs > 0 ? layouts + 2 * (game % pairs) : nullptr;
+    current.moveBudgetMs = moveBudgetMs;
+    current.reset(current.mode, roundIdx + 1);
+}
+
+template <class RulesT>
+void BasicTournament<RulesT>::step(TickEvent *ev) {
+    current.tick();
+    afterTick(ev);
+}
 
-    const char* msg = current.tick();
+template <class RulesT>
+void BasicTournament<RulesT>::afterTick(TickEvent *ev) {
+    TickEvent e = current.lastEvent;
 
     if (current.isFinished()) {
         p1WinsAccum += current.winnerP1();
         p2WinsAccum += current.winnerP2();
         shotsP1Accum += current.playerStats.totalShots;
         shotsP2Accum += current.computerStats.totalShots;
+        if (learnPrior) prior.observeRound(current);
+        for (int k = 0; k < 3; ++k) tierAccum[k] += current.tierCounts[k];
+
+        e.flags |= TICK_ROUND_END;
+        e.winner = current.winnerP1() ? 1 : 2;
+        e.shotsP1 = static_cast<uint16_t>(current.playerStats.totalShots);
+        e.shotsP2 = static_cast<uint16_t>(current.computerStats.totalShots);
+
         currentRoundIdx++;
-        if (currentRoundIdx < totalRounds) {
-            current.reset(current.mode, currentRoundIdx + 1);
-            // Announce new game
-            static std::string startMsg;
-            startMsg = "[New game started: #" + std::to_string(currentRoundIdx + 1) + "]";
-            return startMsg.c_str();
-        } else {
-            static std::string finalMsg;
-            std::ostringstream oss;
-            oss << "[Tournament complete] P1 wins: " << p1WinsAccum
-                << " | P2 wins: " << p2WinsAccum
-                << " | P1 avg shots: "
-                << std::fixed << std::setprecision(2)
-                << (totalRounds ? double(shotsP1Accum)/totalRounds : 0.0)
-                << " | P2 avg shots: "
-                << (totalRounds ? double(shotsP2Accum)/totalRounds : 0.0);
-            finalMsg = oss.str();
-            return finalMsg.c_str();
-        }
+        if (currentRoundIdx < totalRounds) beginRound(currentRoundIdx);
+        else e.flags |= TICK_TOURNAMENT_END;
+    }
+    if (ev) *ev = e;
+}
+
+template <class RulesT>
+int BasicTournament<RulesT>::tickBatch(int n, TickEvent *out) {
+    bool logMoves = current.logMoves;
+    current.logMoves = false;
+    int written = 0;
+    while (written < n && !done()) step(&out[written++]);
+    current.logMoves = logMoves;
+    return written;
+}
+
+template <class RulesT>
+const char* BasicTournament<RulesT>::tick() {
+    if (done()) return "[Tournament finished]";
+
+    TickEvent ev;
+    step(&ev);
+
+    if (ev.flags & TICK_TOURNAMENT_END) {
+        std::snprintf(tickLog, sizeof(tickLog),
+                      "[Tournament complete] P1 wins: %d | P2 wins: %d | P1 avg shots: %.2f | P2 avg shots: %.2f",
+                      p1WinsAccum, p2WinsAccum,
+                      totalRounds ? double(shotsP1Accum)/totalRounds : 0.0,
+                      totalRounds ? double(shotsP2Accum)/totalRounds : 0.0);
+        return tickLog;
     }
-    return msg;
+    if (ev.flags & TICK_ROUND_END) {
+        // Announce new game
+        std::snprintf(tickLog, sizeof(tickLog), "[New game started: #%d]", currentRoundIdx + 1);
+        return tickLog;
+    }
+    return current.lastLog;
 }
 
-int Tournament::done() const {
+template <class RulesT>
+int BasicTournament<RulesT>::done() const {
     return (currentRoundIdx >= totalRounds && current.isFinished()) ? 1 : 0;
 }
 
-const float* Tournament::snapshotBoard() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::snapshotBoard() {
     return current.snapshotBoard(true);
 }
 
-const float* Tournament::getHeatmapSnapshot() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::getHeatmapSnapshot() {
     return current.getHeatmapSnapshot();
 }
 
-const float* Tournament::snapshotPlayer1Board() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::snapshotPlayer1Board() {
     return current.snapshotPlayer1Board();
 }
 
-const float* Tournament::snapshotPlayer2Board() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::snapshotPlayer2Board() {
     return current.snapshotPlayer2Board();
 }
 
-const float* Tournament::getPlayer1Heatmap() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::getPlayer1Heatmap() {
     return current.getPlayer1Heatmap();
 }
 
-const float* Tournament::getPlayer2Heatmap() {
+template <class RulesT>
+const float* BasicTournament<RulesT>::getPlayer2Heatmap() {
     return current.getPlayer2Heatmap();
 }
 
 // Player move handling - allows human to click on board
-int RoundState::makePlayerMove(int row, int col) {
+template <class RulesT>
+int BasicRoundState<RulesT>::makePlayerMove(int row, int col) {
+    AIWeightsScope useWeights(weights);
     // Only allow if mode=2 (player vs AI), turn=0 (player's turn), not game over, and valid cell
     if (mode != 2 || turn != 0 || gameOver) return 0;
-    if (row < 0 || row >= NUM_ROWS || col < 0 || col >= NUM_COLS) return 0;
-    if (!checkShotIsAvailable(computerBoard, row, col)) return 0; // already shot
+    if (row < 0 || row >= RulesT::ROWS || col < 0 || col >= RulesT::COLS) return 0;
+    if (!checkShotIsAvailable<RulesT>(computerBoard, row, col)) return 0; // already shot
 
     // Execute the shot on the computer's board
-    int res = updateBoard(computerBoard, row, col, computerShipSizes);
+    int res = updateBoard<RulesT>(computerBoard, row, col, computerShipSizes);
+    shotCells[0][shotCount[0]++] = static_cast<uint8_t>(row * RulesT::COLS + col);
     bool sunk = false;
 
     if (res != -1) {
-        sunk = updateShipSize(computerShipSizes, res);
+        sunk = updateShipSize<RulesT>(computerShipSizes, res);
         playerStats.hits++;
-        liveHitsP1[row][col]++;
+        liveHits[0].set(row * RulesT::COLS + col);
+        if (sunk) sunkShips[0].add(liveHits[0], row, col, RulesT::SIZES[res]);
     } else {
         playerStats.misses++;
-        liveMissesP1[row][col]++;
+        liveMisses[0].set(row * RulesT::COLS + col);
     }
     playerStats.totalShots++;
 
@@ -368,34 +608,26 @@ int RoundState::makePlayerMove(int row, int col) {
         (100.0 * playerStats.hits / playerStats.totalShots) : 0.0;
 
     // Build view and update live probabilities
-    char view[NUM_ROWS][NUM_COLS];
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        for (int c = 0; c < NUM_COLS; ++c) {
-            if (liveHitsP1[r][c] > 0) view[r][c] = 'X';
-            else if (liveMissesP1[r][c] > 0) view[r][c] = 'm';
-            else view[r][c] = '-';
-        }
-    }
-    computePlacementProbabilities(view, computerShipSizes, liveProbP1);
+    char view[RulesT::ROWS][RulesT::COLS];
+    observedView(0, view);
+    computePlacementProbabilities<RulesT>(view, computerShipSizes, liveProbP1);
+    publishShot(0, row, col, res != -1);
 
     // Log
-    {
-        std::ostringstream oss;
-        oss << "Player fires (" << row << "," << col << ")";
-        if (res != -1) oss << " -> HIT" << (sunk ? " + SUNK" : "");
-        else oss << " -> miss";
-        lastLog = oss.str();
-    }
+    std::snprintf(lastLog, sizeof(lastLog), "Player fires (%d,%d) -> %s", row, col,
+                  res == -1 ? "miss" : sunk ? "HIT + SUNK" : "HIT");
 
     // Update player targeting state
-    updateTargetStateAfterResult(p1Target, computerBoard, row, col, res, sunk, computerShipSizes);
+    char board[RulesT::ROWS][RulesT::COLS];
+    aiBoard(0, board);
+    updateTargetStateAfterResult<RulesT>(p1Target, board, row, col, res, sunk, computerShipSizes);
 
     // Check win
-    if (isWinner(computerShipSizes)) {
+    if (isWinner<RulesT>(computerShipSizes)) {
         gameOver = true;
         playerStats.won = true;
         computerStats.won = false;
-        lastLog = "Player wins!";
+        setLog("Player wins!");
         return res != -1 ? 2 : 1; // 2=hit, 1=miss
     }
 
@@ -408,13 +640,21 @@ int RoundState::makePlayerMove(int row, int col) {
     return 1;
 }
 
-int RoundState::isPlayerTurn() const {
+template <class RulesT>
+int BasicRoundState<RulesT>::isPlayerTurn() const {
     return (mode == 2 && turn == 0 && !gameOver) ? 1 : 0;
 }
 
-void RoundState::advanceAITurn() {
+template <class RulesT>
+void BasicRoundState<RulesT>::advanceAITurn() {
     // Force the AI to take a turn (call tick once if it's AI's turn)
     if (mode == 2 && turn == 1 && !gameOver) {
         tick();
     }
 }
+
+#define INSTANTIATE_TOURNAMENT(RulesT)           \
+    template struct BasicPlacementPrior<RulesT>; \
+    template struct BasicRoundState<RulesT>;     \
+    template struct BasicTournament<RulesT>;
+FOR_EACH_GAME_RULES(INSTANTIATE_TOURNAMENT)
@@ -1,60 +1,171 @@
 #pragma once
-#include <string>
-#include <vector>
-#include <queue>
+#include <type_traits>
 #include "battleship.h"
 #include "MLforAI.h"
 
 enum class GamePhase { Init, PlayerTurn, AITurn, Finished };
 
-struct RoundState {
+// Rounds, priors and tournaments are templated on the rule set (Rules.h) like the
+// move pipeline; the unprefixed names are the standard game's, which is the one
+// the browser, the move server and the policy model know.
+template <class RulesT> struct BasicRoundState;
+
+// Render state shared with JS without copies: the engine keeps this block current
+// as shots land and bumps `generation` on every change, so the page reads HEAP
+// views over it and skips frames where the generation has not moved.
+// Standard byte layout (mirrored in index.html): generation @0, round @4, boards @8, heat @208.
+template <class RulesT>
+struct BasicSharedGameState {
+    uint32_t generation = 0;
+    uint32_t round = 0;
+    int8_t board[2][RulesT::CELLS] = {{0}};  // [0] Player1's board, [1] Player2's: 1 hit, -1 miss, 0 other
+    float heat[2][RulesT::CELLS] = {{0}};    // [0] P1's targeting heatmap, [1] P2's
+};
+typedef BasicSharedGameState<StandardRules> SharedGameState;
+static_assert(sizeof(SharedGameState) == 8 + 2 * NUM_ROWS * NUM_COLS * 5, "SharedGameState layout is shared with JS");
+
+// Bits of TickEvent::flags
+enum TickEventFlags {
+    TICK_HIT = 1,
+    TICK_SUNK = 2,
+    TICK_SKIPPED = 4,           // no shot was fired (invalid cell or round already over)
+    TICK_ROUND_END = 8,         // winner/shots fields are valid
+    TICK_TOURNAMENT_END = 16,
+};
+
+// Fixed-size binary record of one tick, written by Tournament::tickBatch.
+// index.html decodes the same 12-byte little-endian layout.
+struct TickEvent {
+    uint8_t player;     // 0 Player1, 1 Player2
+    uint8_t cell;       // row * cols + col
+    uint8_t flags;      // TickEventFlags
+    int8_t ship;        // index of the ship hit, -1 on a miss
+    uint16_t round;     // 1-based round the shot belongs to
+    uint8_t winner;     // round end: 1 Player1, 2 Player2
+    uint8_t reserved;
+    uint16_t shotsP1;   // round end: shots each player fired that round
+    uint16_t shotsP2;
+};
+static_assert(sizeof(TickEvent) == 12, "TickEvent layout is shared with JS");
+
+// Cross-round learned prior over opponent ship placement.
+// Each cell keeps exponentially decayed hit/shot counts that are smoothed toward
+// the blank-board placement map. The decay is one shared scale rather than a
+// pass over the board: a round's shots are added at weight `scale`, which grows
+// by 1/decay per round, and read() divides it back out. So only cells shot in a
+// round are touched when it ends.
+template <class RulesT>
+struct BasicPlacementPrior {
+    double decay = 0.95;      // per-round retention of older observations
+    double strength = 8.0;    // pseudo-shots pulling each cell toward the blank-board map
+
+    double hits[RulesT::ROWS][RulesT::COLS] = {{0}};    // decayed counts times scale
+    double shots[RulesT::ROWS][RulesT::COLS] = {{0}};
+    double scale = 1.0;
+    double gain = 1.0;        // blank-board map scale / mean ship-cell rate
+    int rounds = 0;
+
+    void reset();
+    // Fold both boards' shot outcomes of a finished round into the prior
+    void observeRound(const BasicRoundState<RulesT> &rs);
+    // Hit probability of every cell, on the blank-board map's scale
+    void read(double out[RulesT::ROWS][RulesT::COLS]) const;
+};
+typedef BasicPlacementPrior<StandardRules> PlacementPrior;
+
+// One game. Plain data only (fixed arrays, bitboards, inline queues and raw
+// pointers), so rounds can be copied with memcpy and packed into large arrays.
+template <class RulesT>
+struct BasicRoundState {
+    // Shots are recorded as one byte per cell (shotCells, TickEvent::cell)
+    static_assert(RulesT::CELLS <= 256, "cells must fit in a byte");
+
     // Config
     int mode = 3;          // 1 PvP, 2 PvC, 3 CvC
     int roundIndex = 1;
 
     // Boards
-    char playerBoard[NUM_ROWS][NUM_COLS];
-    char computerBoard[NUM_ROWS][NUM_COLS];
+    char playerBoard[RulesT::ROWS][RulesT::COLS];
+    char computerBoard[RulesT::ROWS][RulesT::COLS];
 
     // Ship health
-    int playerShipSizes[NUM_SHIPS];
-    int computerShipSizes[NUM_SHIPS];
+    int playerShipSizes[RulesT::SHIPS];
+    int computerShipSizes[RulesT::SHIPS];
 
     // Stats
     Stats playerStats{}, computerStats{};
 
-    // Learning arrays
-    int hitCount[NUM_ROWS][NUM_COLS] = {0};
-    int missCount[NUM_ROWS][NUM_COLS] = {0};
-    double hitProb[NUM_ROWS][NUM_COLS] = {0};
-    // Per-player live observation arrays: what each player has observed of the opponent
-    int liveHitsP1[NUM_ROWS][NUM_COLS] = {0};
-    int liveMissesP1[NUM_ROWS][NUM_COLS] = {0};
-    double liveProbP1[NUM_ROWS][NUM_COLS] = {0};
-
-    int liveHitsP2[NUM_ROWS][NUM_COLS] = {0};
-    int liveMissesP2[NUM_ROWS][NUM_COLS] = {0};
-    double liveProbP2[NUM_ROWS][NUM_COLS] = {0};
+    // Global hit probability (seeded from the prior or the blank-board map)
+    double hitProb[RulesT::ROWS][RulesT::COLS] = {{0}};
+    // What each player has observed of the opponent: [0] Player1's shots, [1] Player2's
+    BasicBitboard<RulesT::CELLS> liveHits[2];
+    BasicBitboard<RulesT::CELLS> liveMisses[2];
+    // Ships each player has sunk, resolved to the hits they occupy
+    BasicSunkShips<RulesT> sunkShips[2];
+    // Per-player live placement maps built from those observations
+    double liveProbP1[RulesT::ROWS][RulesT::COLS] = {{0}};
+    double liveProbP2[RulesT::ROWS][RulesT::COLS] = {{0}};
 
     // Targeting states
-    TargetState p1Target{}, p2Target{};
+    BasicTargetState<RulesT> p1Target{}, p2Target{};
 
     // Control
     int turn = 0;              // 0 -> Player1, 1 -> Player2
     int turnCount = 0;
     bool gameOver = false;
 
-    // Scratch log buffer (returned per tick)
-    std::string lastLog;
+    // Shots fired this round per shooter, in order (row * cols + col)
+    int shotCount[2] = {0, 0};
+    uint8_t shotCells[2][RulesT::CELLS];
+
+    // Optional cross-round prior; when set, reset() seeds hitProb from it
+    const BasicPlacementPrior<RulesT> *prior = nullptr;
+
+    // Optional weights for this round's AIs (null: the thread's aiWeights())
+    const AIWeights *weights = nullptr;
+
+    // Per-round generator; seed it before reset() to make the round reproducible
+    GameRng rng;
+
+    // Optional distilled policy per player; a player with one shoots by it instead
+    // of the scoring pipeline (see chooseAIMovePolicy). Standard rules only: other
+    // rule sets ignore it.
+    const PolicyModel *policy[2] = {nullptr, nullptr};
+
+    // Optional pregenerated fleets: reset() lays out player 1's board from fleets[0]
+    // and player 2's from fleets[1] instead of sampling them
+    const BasicFleetLayout<RulesT> *fleets = nullptr;
+
+    // AI move time budget in ms (< 0: unbudgeted selection). Budgeted moves use
+    // chooseAIMoveWithin, which depends on timing and so is not replay-deterministic.
+    double moveBudgetMs = -1.0;
+    int lastTier = MOVE_TIER_FULL;
+    int tierCounts[3] = {0, 0, 0};
+
+    // Scratch log buffer (returned per tick); batched ticks skip formatting it
+    char lastLog[64] = {0};
+    bool logMoves = true;
+    // Refresh both players' live maps after every shot (for renderers; headless
+    // engines turn it off, moves never read them)
+    bool liveMaps = true;
+    // Outcome of the last tick
+    TickEvent lastEvent{};
+    // Optional render block kept in sync with the boards and heatmaps
+    BasicSharedGameState<RulesT> *shared = nullptr;
 
     void reset(int mode_, int round_);
     // Advances one logical step; returns short log
     const char* tick();
-    // Board snapshot for JS (100 floats: 0 empty, 1 hit, -1 miss, optional >1 ship id)
+    // Second half of tick(): fires the side to move's shot at (row, col), falling back
+    // to the global heatmap when the cell is taken, and passes the turn
+    const char* fire(int row, int col);
+    // Board the shooter's AI moves on: the target board with its resolved sunk cells marked
+    void aiBoard(int shooter, char board[RulesT::ROWS][RulesT::COLS]) const;
+    // Board snapshot for JS (one float per cell: 0 empty, 1 hit, -1 miss, optional >1 ship id)
     const float* snapshotBoard(bool showComputerBoard = true);
     const float* snapshotPlayer1Board(); // Player 1's board (what P2 is attacking)
     const float* snapshotPlayer2Board(); // Player 2's board (what P1 is attacking)
-    // Heatmap snapshot for JS (100 floats: 0.0-1.0 probabilities)
+    // Heatmap snapshot for JS (one float per cell: 0.0-1.0 probabilities)
     const float* getHeatmapSnapshot();
     const float* getPlayer1Heatmap(); // P1's targeting heatmap
     const float* getPlayer2Heatmap(); // P2's targeting heatmap
@@ -64,20 +175,76 @@ struct RoundState {
     void advanceAITurn();
     int winnerP1() const { return playerStats.won ? 1 : 0; }
     int winnerP2() const { return computerStats.won ? 1 : 0; }
+    // Write the whole round / one shot plus both heatmaps into `shared`
+    void publishAll();
+    void publishShot(int shooter, int row, int col, bool hit);
+private:
+    void publishHeat();
+    void refreshLiveMaps();
+    void setLog(const char *msg);
+    // Shooter's view of the opponent board ('X' hit, 'm' miss, SUNK resolved, '-' unknown)
+    void observedView(int shooter, char view[RulesT::ROWS][RulesT::COLS]) const;
 };
+typedef BasicRoundState<StandardRules> RoundState;
+static_assert(std::is_trivially_copyable<RoundState>::value, "RoundState must stay plain data");
+// Rounds are copied whole (replays) and kept per lane (BatchTournament), so any
+// growth should be deliberate. The figure holds for 64-bit pointers.
+static_assert(sizeof(void *) != 8 || sizeof(RoundState) == 3736, "RoundState size changed");
 
 // Tournament controller
-struct Tournament {
+template <class RulesT>
+struct BasicTournament {
     int totalRounds = 10;
     int currentRoundIdx = 0;
-    RoundState current;
+    BasicRoundState<RulesT> current;
     long long shotsP1Accum = 0;
     long long shotsP2Accum = 0;
     int p1WinsAccum = 0;
     int p2WinsAccum = 0;
 
-    void start(int mode, int n);
+    // Persistent placement prior shared by every round of this tournament (`tuner
+    // prior=1`, the setLearnPrior export). Off by default: it learns only from
+    // cells the AI chose to shoot, and in 600-game sweeps it has not lowered
+    // shots-to-win.
+    bool learnPrior = false;
+    BasicPlacementPrior<RulesT> prior;
+
+    // Round k plays game (firstGame + k) of the sweep seeded by `seed`
+    uint64_t seed = 0;
+    long long firstGame = 0;
+
+    // Optional weights used by every round instead of the global ones
+    const AIWeights *weights = nullptr;
+
+    // Optional distilled policy per player, installed on every round
+    const PolicyModel *policy[2] = {nullptr, nullptr};
+
+    // Optional pregenerated layouts (e.g. a mapped LayoutCorpus): game g takes the
+    // pair starting at layouts[2 * (g mod layoutCount / 2)]
+    const BasicFleetLayout<RulesT> *layouts = nullptr;
+    long long layoutCount = 0;
+
+    // Optional render block attached to every round (the browser bridge owns it)
+    BasicSharedGameState<RulesT> *shared = nullptr;
+
+    // Per-move AI time budget applied to every round (< 0: unbudgeted)
+    double moveBudgetMs = -1.0;
+    long long tierAccum[3] = {0, 0, 0};
+
+    // Round and tournament announcements returned by tick()
+    char tickLog[128] = {0};
+
+    void start(int mode, int n, uint64_t seed_ = 0, long long firstGame_ = 0);
+    // Seeds and resets `current` for the given round index
+    void beginRound(int roundIdx);
     const char* tick();
+    // Plays one tick, folding a finished round into the totals and starting the
+    // next; fills ev when given. Call only while !done().
+    void step(TickEvent *ev);
+    // The part of step() after current.tick() (engines that fire moves themselves call it)
+    void afterTick(TickEvent *ev);
+    // Plays up to n ticks without formatting logs; returns the events written to out
+    int tickBatch(int n, TickEvent *out);
     int done() const;
     const float* snapshotBoard();
     const float* snapshotPlayer1Board();
@@ -86,3 +253,4 @@ struct Tournament {
     const float* getPlayer1Heatmap();
     const float* getPlayer2Heatmap();
 };
+typedef BasicTournament<StandardRules> Tournament;
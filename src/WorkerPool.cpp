@@ -0,0 +1,98 @@
+#include "WorkerPool.h"
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#endif
+
+// Depth of pool jobs running on this thread (nested parallelFor runs inline)
+static thread_local int tJobDepth = 0;
+
+WorkerPool::WorkerPool(int threads) {
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back([this] { workerLoop(); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : workers) t.join();
+}
+
+// Requested size of the shared pool (0: the hardware's) and whether it exists yet
+static std::mutex sharedMtx;
+static int sharedSize = 0;
+static bool sharedCreated = false;
+
+bool WorkerPool::setSharedSize(int threads) {
+    std::lock_guard<std::mutex> lock(sharedMtx);
+    if (sharedCreated) return false;
+    sharedSize = threads > 0 ? threads : 0;
+    return true;
+}
+
+WorkerPool &WorkerPool::shared() {
+    static WorkerPool pool([] {
+        std::lock_guard<std::mutex> lock(sharedMtx);
+        sharedCreated = true;
+        if (sharedSize > 0) return sharedSize;
+        return std::thread::hardware_concurrency() > 0 ? static_cast<int>(std::thread::hardware_concurrency()) : 1;
+    }());
+    return pool;
+}
+
+// Claims and runs indices of the current job until none are left
+void WorkerPool::drain() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (job && nextIndex < jobSize) {
+        int i = nextIndex++;
+        const std::function<void(int)> *fn = job;
+        lock.unlock();
+        ++tJobDepth;
+        (*fn)(i);
+        --tJobDepth;
+        lock.lock();
+        if (--pending == 0) done.notify_all();
+    }
+}
+
+void WorkerPool::workerLoop() {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drain();
+    }
+}
+
+void WorkerPool::parallelFor(int n, const std::function<void(int)> &fn) {
+    if (n <= 0) return;
+    bool inlineOnly = workers.empty() || n == 1 || tJobDepth > 0;
+#ifdef __EMSCRIPTEN__
+    // The browser's main thread must not block, so it never waits on workers
+    inlineOnly = inlineOnly || emscripten_is_main_browser_thread();
+#endif
+    if (inlineOnly) {
+        for (int i = 0; i < n; ++i) fn(i);
+        return;
+    }
+    std::lock_guard<std::mutex> jobLock(jobMtx);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        job = &fn;
+        jobSize = n;
+        nextIndex = 0;
+        pending = n;
+        ++generation;
+    }
+    wake.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lock(mtx);
+    done.wait(lock, [&] { return pending == 0; });
+    job = nullptr;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run index-parallel jobs.
+//
+// parallelFor(n, fn) calls fn(i) for every i in [0, n) across the workers and
+// the calling thread and returns once all calls have finished. One job runs at
+// a time (concurrent callers queue); a parallelFor issued from inside a job runs
+// inline on that thread, as does one issued on the browser's main thread.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // Worker threads plus the calling thread
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    void parallelFor(int n, const std::function<void(int)> &fn);
+
+    // Process-wide pool sized to the hardware (the browser's pthread pool under WASM)
+    // unless setSharedSize chose a size first
+    static WorkerPool &shared();
+    // Threads of shared(), calling thread included; false once shared() exists
+    static bool setSharedSize(int threads);
+
+private:
+    void workerLoop();
+    void drain();
+
+    std::vector<std::thread> workers;
+    std::mutex jobMtx;      // held by the thread whose job is running
+    std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)> *job = nullptr;
+    int jobSize = 0;
+    int nextIndex = 0;
+    int pending = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+};
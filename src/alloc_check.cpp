@@ -0,0 +1,49 @@
+#include "AllocCounter.h"
+#include "Tournament.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Allocation check, built as its own binary (scripts/alloc_check.sh) so the
+// counting operator new never ships in the tuner:
+//   tuner_allocs [games=<n>] [seed=<s>] [budget=<ms>]
+// Plays n CvC games through Tournament::tick, with move logs and live maps on,
+// and counts heap allocations after the first game (warm-up: the worker pool,
+// first-use statics). Exits 1 if the steady-state loop allocated at all.
+int main(int argc, char **argv) {
+    int games = 50;
+    unsigned long long seed = 1;
+    double budgetMs = -1.0;
+    for (int i = 1; i < argc; ++i) {
+        const char *eq = std::strchr(argv[i], '=');
+        if (!eq) {
+            std::fprintf(stderr, "usage: tuner_allocs [games=<n>] [seed=<s>] [budget=<ms>]\n");
+            return 2;
+        }
+        const char *v = eq + 1;
+        if (!std::strncmp(argv[i], "games=", 6)) games = std::atoi(v);
+        else if (!std::strncmp(argv[i], "seed=", 5)) seed = std::strtoull(v, nullptr, 10);
+        else if (!std::strncmp(argv[i], "budget=", 7)) budgetMs = std::atof(v);
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (games < 2) games = 2;
+
+    Tournament t;
+    t.moveBudgetMs = budgetMs;
+    long long start = heapAllocations();
+    t.start(3, games, seed);
+    while (!t.done() && t.currentRoundIdx < 1) t.tick();
+    long long warm = heapAllocations();
+    long long ticks = 0;
+    while (!t.done()) {
+        t.tick();
+        ticks++;
+    }
+    long long steady = heapAllocations() - warm;
+    std::printf("warm-up allocations: %lld\nsteady-state allocations: %lld over %d games, %lld ticks\n",
+                warm - start, steady, games - 1, ticks);
+    return steady == 0 ? 0 : 1;
+}
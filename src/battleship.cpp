@@ -1,16 +1,20 @@
 #include "battleship.h"
 #include "MLforAI.h"
 
-void welcomeScreen() {
-    cout << "***** Welcome to Battleship! *****\n\n";
-    cout << "Rules of the Game:\n";
-    cout << "1. Player1 is you and Player2 is the computer.\n";
-    cout << "2. Columns are A–J, rows are 0-9.\n";
-    cout << "3. Ships: carrier(5), battleship(4), cruiser(3), submarine(3), destroyer(2).\n";
-    cout << "4. '*' marks a hit; 'm' marks a miss; you cannot shoot the same cell twice.\n";
-    cout << "5. First to sink all ships wins.\n\n";
-    cout << "Press Enter to start...";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+static thread_local GameRng tDefaultRng;
+static thread_local GameRng *tActiveRng = nullptr;
+
+GameRng &gameRng() {
+    return tActiveRng ? *tActiveRng : tDefaultRng;
+}
+
+GameRngScope::GameRngScope(GameRng &rng) : previous(tActiveRng) { tActiveRng = &rng; }
+GameRngScope::~GameRngScope() { tActiveRng = previous; }
+
+uint64_t gameSeed(uint64_t masterSeed, long long gameIndex) {
+    GameRng mix;
+    mix.seed(masterSeed ^ (0xD1B54A32D192ED03ULL * static_cast<uint64_t>(gameIndex + 1)));
+    return mix.next();
 }
 
 /**
@@ -18,9 +22,10 @@ void welcomeScreen() {
  *
  * @param board The board to initialize.
  */
-void initializeBoard(char board[NUM_ROWS][NUM_COLS]) {
-    for (int r = 0; r < NUM_ROWS; ++r)
-        for (int c = 0; c < NUM_COLS; ++c)
+template <class RulesT>
+void initializeBoard(char board[RulesT::ROWS][RulesT::COLS]) {
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
             board[r][c] = '-';
 }
 
@@ -34,13 +39,14 @@ void initializeBoard(char board[NUM_ROWS][NUM_COLS]) {
  * @param horizontal If true, the ship is placed horizontally; if false, the ship is placed vertically.
  * @return true if the ship can be placed at the given position, false otherwise.
  */
-bool canPlaceShip(const char board[NUM_ROWS][NUM_COLS], int row, int col, int size, bool horizontal) {
-    if (row < 0 || row >= NUM_ROWS || col < 0 || col >= NUM_COLS) return false;
+template <class RulesT>
+bool canPlaceShip(const char board[RulesT::ROWS][RulesT::COLS], int row, int col, int size, bool horizontal) {
+    if (row < 0 || row >= RulesT::ROWS || col < 0 || col >= RulesT::COLS) return false;
     if (horizontal) {
-        if (col + size > NUM_COLS) return false;
+        if (col + size > RulesT::COLS) return false;
         for (int i = 0; i < size; ++i) if (board[row][col + i] != '-') return false;
     } else {
-        if (row + size > NUM_ROWS) return false;
+        if (row + size > RulesT::ROWS) return false;
         for (int i = 0; i < size; ++i) if (board[row + i][col] != '-') return false;
     }
     return true;
@@ -56,7 +62,8 @@ bool canPlaceShip(const char board[NUM_ROWS][NUM_COLS], int row, int col, int si
  * @param symbol The symbol to use to mark the ship on the board.
  * @param horizontal If true, the ship is placed horizontally; if false, the ship is placed vertically.
  */
-void placeShip(char board[NUM_ROWS][NUM_COLS], int row, int col, int size, char symbol, bool horizontal) {
+template <class RulesT>
+void placeShip(char board[RulesT::ROWS][RulesT::COLS], int row, int col, int size, char symbol, bool horizontal) {
     if (horizontal) for (int i = 0; i < size; ++i){
         board[row][col + i] = symbol;
     }else {
@@ -106,96 +113,158 @@ char colToLetter(int col) {
     return static_cast<char>('A' + col);
 }
 
-/**
- * Place all ships on the board in a biased manner, with the bias being in the center of the board.
- * The bias is generated by the generatePlacementWeights function, which assigns higher weights to the center of the board.
- * The ships are placed one by one, with the Carrier being placed first, the Battleship being placed second, and so on.
- * Each ship is placed at a random position that is not already occupied by another ship, and the orientation of the ship is also randomly chosen.
- * This function is used for Player2 (the computer) to place its ships on the board.
- */
-void biasedPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]) {
-    double weights[NUM_ROWS][NUM_COLS];
-    generatePlacementWeights(weights);
+template <class RulesT>
+BasicFleetSampler<RulesT>::BasicFleetSampler(const double cellWeights[ROWS][COLS]) {
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        ShipTable &t = ships[s];
+        const int size = RulesT::SIZES[s];
+        double total = 0.0;
+        for (int r = 0; r < ROWS; ++r)
+            for (int c = 0; c < COLS; ++c)
+                for (int h = 0; h < 2; ++h) {
+                    bool horizontal = h == 0;
+                    if ((horizontal ? c : r) + size > (horizontal ? COLS : ROWS)) continue;
+                    Placement &p = t.placements[t.count];
+                    p.row = static_cast<int8_t>(r);
+                    p.col = static_cast<int8_t>(c);
+                    p.horizontal = horizontal;
+                    for (int i = 0; i < size; ++i)
+                        p.cells.set(horizontal ? r * COLS + c + i : (r + i) * COLS + c);
+                    t.weight[t.count] = cellWeights[r][c];
+                    total += cellWeights[r][c];
+                    t.count++;
+                }
+
+        // Vose's alias method: scaled weights below 1 are topped up by one above 1
+        double scaled[MAX_PLACEMENTS];
+        uint16_t small[MAX_PLACEMENTS], large[MAX_PLACEMENTS];
+        int ns = 0, nl = 0;
+        for (int i = 0; i < t.count; ++i) {
+            scaled[i] = t.weight[i] * t.count / total;
+            t.alias[i] = static_cast<uint16_t>(i);
+            if (scaled[i] < 1.0) small[ns++] = static_cast<uint16_t>(i);
+            else large[nl++] = static_cast<uint16_t>(i);
+        }
+        while (ns > 0 && nl > 0) {
+            int lo = small[--ns], hi = large[--nl];
+            t.accept[lo] = scaled[lo];
+            t.alias[lo] = static_cast<uint16_t>(hi);
+            scaled[hi] -= 1.0 - scaled[lo];
+            if (scaled[hi] < 1.0) small[ns++] = static_cast<uint16_t>(hi);
+            else large[nl++] = static_cast<uint16_t>(hi);
+        }
+        // Whatever is left is 1 up to rounding
+        while (nl > 0) t.accept[large[--nl]] = 1.0;
+        while (ns > 0) t.accept[small[--ns]] = 1.0;
+    }
+}
 
-    for (int s = 0; s < NUM_SHIPS; ++s) {
-        bool placed = false;
-        while (!placed) {
-            auto [row, col] = pickWeightedCell(weights);
-            bool horizontal = rand() % 2;
+template <class RulesT>
+static BasicBitboard<RulesT::CELLS> occupiedCells(const char board[RulesT::ROWS][RulesT::COLS]) {
+    BasicBitboard<RulesT::CELLS> occupied;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c)
+            if (board[r][c] != '-') occupied.set(r * RulesT::COLS + c);
+    return occupied;
+}
 
-            if (canPlaceShip(board, row, col, SHIP_SIZES[s], horizontal)) {
-                placeShip(board, row, col, SHIP_SIZES[s], SHIP_SYMBOLS[s], horizontal);
-                placed = true;
+template <class RulesT>
+void BasicFleetSampler<RulesT>::sample(char board[ROWS][COLS], BasicFleetLayout<RulesT> *layout) const {
+    BasicBitboard<RulesT::CELLS> occupied = occupiedCells<RulesT>(board);
+    GameRng &rng = gameRng();
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        const ShipTable &t = ships[s];
+        int pick = -1;
+        // A draw that overlaps is simply repeated: the accepted ones follow the
+        // weights restricted to the legal placements
+        for (int attempt = 0; attempt < ALIAS_TRIES && pick < 0; ++attempt) {
+            int i = rng.below(t.count);
+            if (rng.unit() >= t.accept[i]) i = t.alias[i];
+            if (!t.placements[i].cells.intersects(occupied)) pick = i;
+        }
+        if (pick < 0) {
+            double legal = 0.0;
+            for (int i = 0; i < t.count; ++i)
+                if (!t.placements[i].cells.intersects(occupied)) legal += t.weight[i];
+            double x = rng.unit() * legal;
+            for (int i = 0; i < t.count; ++i) {
+                if (t.placements[i].cells.intersects(occupied)) continue;
+                pick = i;
+                x -= t.weight[i];
+                if (x < 0.0) break;
             }
+            if (pick < 0) continue;     // no legal placement left (not reachable with the standard fleet)
         }
+        const Placement &p = t.placements[pick];
+        placeShip<RulesT>(board, p.row, p.col, RulesT::SIZES[s], RulesT::symbol(s), p.horizontal);
+        occupied |= p.cells;
+        if (layout) layout->placement[s] = static_cast<typename BasicFleetLayout<RulesT>::Index>(pick);
     }
 }
 
-/**
- * Manually place all ships on the board. The user is prompted to choose between manual and random placement.
- * If the user chooses manual placement, they are prompted to enter the start row and column for each ship,
- * as well as the orientation (horizontal or vertical). The program checks for invalid inputs and overlap
- * with existing ships. If the user chooses random placement, the randomlyPlaceShipsOnBoard function is called.
- */
-void manuallyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]) {
-    cout << "\n1. Manual placement\n2. Random placement\nChoice: ";
-    int choice; cin >> choice;
-    if (choice == 2) { randomlyPlaceShipsOnBoard(board); return; }
-
-    for (int i = 0; i < NUM_SHIPS; ++i) {
-        bool placed = false;
-        while (!placed) {
-            cout << "Place " << SHIP_NAMES[i] << " (size " << SHIP_SIZES[i] << ")\n";
-            cout << "Enter start row and column (e.g. 3 D or D 3): ";
-            auto [row, col] = parseFlexibleInput();
+template <class RulesT>
+bool BasicFleetSampler<RulesT>::place(char board[ROWS][COLS], const BasicFleetLayout<RulesT> &layout) const {
+    BasicBitboard<RulesT::CELLS> occupied = occupiedCells<RulesT>(board);
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        if (layout.placement[s] >= ships[s].count) return false;
+        const BasicBitboard<RulesT::CELLS> &cells = ships[s].placements[layout.placement[s]].cells;
+        if (cells.intersects(occupied)) return false;
+        occupied |= cells;
+    }
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        const Placement &p = ships[s].placements[layout.placement[s]];
+        placeShip<RulesT>(board, p.row, p.col, RulesT::SIZES[s], RulesT::symbol(s), p.horizontal);
+    }
+    return true;
+}
 
-            cout << "Orientation [0=H,1=V]: ";
-            int o; cin >> o; bool horiz = (o == 0);
+template <class RulesT>
+static BasicFleetSampler<RulesT> makeFleetSampler(FleetBias bias) {
+    double weights[RulesT::ROWS][RulesT::COLS];
+    generatePlacementWeights<RulesT>(weights);
+    double peak = 0.0;
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) peak = max(peak, weights[r][c]);
+    // Edge weights mirror the center ones: the border gets the center's weight and back
+    for (int r = 0; r < RulesT::ROWS; ++r)
+        for (int c = 0; c < RulesT::COLS; ++c) {
+            if (bias == FLEET_UNIFORM) weights[r][c] = 1.0;
+            else if (bias == FLEET_EDGE) weights[r][c] = 1.0 + peak - weights[r][c];
+        }
+    return BasicFleetSampler<RulesT>(weights);
+}
 
-            if (row < 0 || row >= NUM_ROWS || col < 0 || col >= NUM_COLS) { cout << "Invalid.\n"; continue; }
-            if (!canPlaceShip(board, row, col, SHIP_SIZES[i], horiz)) { cout << "Overlap/out of bounds.\n"; continue; }
+template <class RulesT>
+const BasicFleetSampler<RulesT> &fleetSampler(FleetBias bias) {
+    static const BasicFleetSampler<RulesT> center = makeFleetSampler<RulesT>(FLEET_CENTER);
+    static const BasicFleetSampler<RulesT> uniform = makeFleetSampler<RulesT>(FLEET_UNIFORM);
+    static const BasicFleetSampler<RulesT> edge = makeFleetSampler<RulesT>(FLEET_EDGE);
+    return bias == FLEET_EDGE ? edge : bias == FLEET_UNIFORM ? uniform : center;
+}
 
-            placeShip(board, row, col, SHIP_SIZES[i], SHIP_SYMBOLS[i], horiz);
-            placed = true;
-            // clearScreen removed for WASM
-            cout << "Player1's Board:\n\n";
-            displayBoard(board, true);
-        }
-    }
+/**
+ * Place all ships on the board in a biased manner, with the bias being in the center of the board.
+ * The bias is generated by the generatePlacementWeights function, which assigns higher weights to the center of the board.
+ * The ships are placed one by one, with the Carrier being placed first, the Battleship being placed second, and so on.
+ * Each ship lands on a legal placement chosen with probability proportional to the weight of its start cell,
+ * in either orientation (see FleetSampler).
+ * This function is used for Player2 (the computer) to place its ships on the board.
+ */
+template <class RulesT>
+void biasedPlaceShipsOnBoard(char board[RulesT::ROWS][RulesT::COLS]) {
+    fleetSampler<RulesT>(FLEET_CENTER).sample(board);
 }
 
 /**
  * Randomly place all ships on the board.
  *
- * For each ship, attempt to randomly place it on the board up to 1000 times. If a ship cannot be
- * placed after 1000 attempts, use a brute-force approach to place the ship.
+ * Each ship, in order, lands on a legal placement chosen uniformly at random (see FleetSampler).
  *
  * @param board The board to place the ships on.
  */
-void randomlyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]) {
-    for (int i = 0; i < NUM_SHIPS; ++i) {
-        bool placed = false;
-        for (int attempts = 0; attempts < 1000 && !placed; ++attempts) {
-            int row = rand() % NUM_ROWS;
-            int col = rand() % NUM_COLS;
-            bool horiz = (rand() % 2 == 0);
-            if (canPlaceShip(board, row, col, SHIP_SIZES[i], horiz)) {
-                placeShip(board, row, col, SHIP_SIZES[i], SHIP_SYMBOLS[i], horiz);
-                placed = true;
-            }
-        }
-        if (!placed) { // brute-force fallback
-            for (int r = 0; r < NUM_ROWS && !placed; ++r)
-                for (int c = 0; c < NUM_COLS && !placed; ++c)
-                    for (int h = 0; h < 2 && !placed; ++h) {
-                        bool horiz = (h == 0);
-                        if (canPlaceShip(board, r, c, SHIP_SIZES[i], horiz)) {
-                            placeShip(board, r, c, SHIP_SIZES[i], SHIP_SYMBOLS[i], horiz);
-                            placed = true;
-                        }
-                    }
-        }
-    }
+template <class RulesT>
+void randomlyPlaceShipsOnBoard(char board[RulesT::ROWS][RulesT::COLS]) {
+    fleetSampler<RulesT>(FLEET_UNIFORM).sample(board);
 }
 
 /**
@@ -204,7 +273,7 @@ void randomlyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]) {
  * @return 0 if Player1 goes first, 1 if Player2 goes first.
  */
 int selectWhoStartsFirst() {
-    int who = rand() % 2;
+    int who = gameRng().below(2);
     // In WASM, no console output
     return who;
 }
@@ -219,8 +288,9 @@ int selectWhoStartsFirst() {
  * @param col The column of the position to check.
  * @return true if the shot is available, false otherwise.
  */
-bool checkShotIsAvailable(const char board[NUM_ROWS][NUM_COLS], int row, int col) {
-    if (row < 0 || row >= NUM_ROWS || col < 0 || col >= NUM_COLS) return false;
+template <class RulesT>
+bool checkShotIsAvailable(const char board[RulesT::ROWS][RulesT::COLS], int row, int col) {
+    if (row < 0 || row >= RulesT::ROWS || col < 0 || col >= RulesT::COLS) return false;
     char cell = board[row][col];
     return cell == '-' || isShipSymbol(cell);
 }
@@ -235,12 +305,13 @@ bool checkShotIsAvailable(const char board[NUM_ROWS][NUM_COLS], int row, int col
  * @param shipSizes The sizes of the ships.
  * @return The index of the ship if the shot hits, -1 if the shot is a miss.
  */
-int updateBoard(char board[NUM_ROWS][NUM_COLS], int row, int col, int shipSizes[]) {
+template <class RulesT>
+int updateBoard(char board[RulesT::ROWS][RulesT::COLS], int row, int col, int shipSizes[]) {
     char &cell = board[row][col];
     if (isShipSymbol(cell)) {
         int idx = -1;
-        for (int i = 0; i < NUM_SHIPS; ++i)
-            if (cell == SHIP_SYMBOLS[i]) { idx = i; break; }
+        for (int i = 0; i < RulesT::SHIPS; ++i)
+            if (cell == RulesT::symbol(i)) { idx = i; break; }
         cell = 'X';
         return idx;
     } else {
@@ -258,8 +329,9 @@ int updateBoard(char board[NUM_ROWS][NUM_COLS], int row, int col, int shipSizes[
  * @param shipSizes An array of the current sizes of the ships.
  * @return true if the player has won the game, false otherwise.
  */
+template <class RulesT>
 bool isWinner(const int shipSizes[]) {
-    for (int i = 0; i < NUM_SHIPS; ++i) if (shipSizes[i] > 0) return false;
+    for (int i = 0; i < RulesT::SHIPS; ++i) if (shipSizes[i] > 0) return false;
     return true;
 }
 
@@ -276,8 +348,9 @@ bool isWinner(const int shipSizes[]) {
  * @param shipIndex The index of the ship to update.
  * @return true if the ship has been sunk, false otherwise.
  */
+template <class RulesT>
 bool updateShipSize(int shipSizes[], int shipIndex) {
-    if (shipIndex < 0 || shipIndex >= NUM_SHIPS) return false;
+    if (shipIndex < 0 || shipIndex >= RulesT::SHIPS) return false;
     if (shipSizes[shipIndex] > 0) {
         --shipSizes[shipIndex];
         return shipSizes[shipIndex] == 0;
@@ -287,136 +360,16 @@ bool updateShipSize(int shipSizes[], int shipIndex) {
 
 // outputStats removed for WASM - no file I/O
 
-/**
- * Checks if a character is a ship symbol.
- * 
- * Iterates over SHIP_SYMBOLS and checks if the given character is equal to any of the symbols.
- * 
- * @param ch The character to check.
- * @return true if the character is a ship symbol, false otherwise.
- */
-bool isShipSymbol(char ch) {
-    for (int i = 0; i < NUM_SHIPS; ++i){
-        if (ch == SHIP_SYMBOLS[i]){
-            return true;
-        }
-    }
-    return false;
-}
-
-/**
- * Displays the board in a human-readable format.
- * The board is displayed as a grid of characters, with row labels on the left and column labels on top.
- * If showShips is false, ship symbols are replaced with '-'.
- * @param board The board to display.
- * @param showShips Whether to show ship symbols or not.
- */
-void displayBoard(const char board[NUM_ROWS][NUM_COLS], bool showShips) {
-    // Print column labels
-    cout << "   ";
-    for (int c = 0; c < NUM_COLS; ++c){
-        cout << static_cast<char>('A' + c) << " ";
-    }
-    cout << "\n";
-
-    // Print board
-    for (int r = 0; r < NUM_ROWS; ++r) {
-        cout << setw(2) << r << " ";
-        for (int c = 0; c < NUM_COLS; ++c) {
-            char cell = board[r][c];
-
-        // If showShips is false, replace ship symbols with '-'
-            if (!showShips && isShipSymbol(cell)){
-                cell = '-';
-            }else{ cout << cell << " ";
-            }
-        }
-        cout << "\n";
-    }
-}
-
-/**
- * Gets a move from the specified player.
- * 
- * If the player is human, prompts the user to enter a target in the format "row colLetter" or "colLetter row".
- * If the player is a computer, randomly selects a target that is still available.
- * 
- * @param type The type of player (human or computer).
- * @param board The current game board.
- * @return A pair of integers representing the row and column of the selected target.
- */
-pair<int,int> getMove(PlayerType type, const char board[NUM_ROWS][NUM_COLS]) {
-    if (type == HUMAN) {
-        cout << "Enter target (row colLetter or colLetter row): ";
-        auto [row, col] = parseFlexibleInput();
-        return {row, col};
-    } else {
-        int row, col;
-        do {
-            row = rand() % NUM_ROWS;
-            col = rand() % NUM_COLS;
-        } while (!checkShotIsAvailable(board, row, col));
-        // Console output removed for WASM
-        return {row, col};
-    }
-}
-
-/**
- * Parses a user input string in a flexible format to extract a row and column target.
- * 
- * The input is expected to be a single line of text, and may contain spaces, commas, and/or
- * letters and digits. The function removes all commas and whitespace, then separates the letters
- * and digits.
- * 
- * If the input is in the format of "row colLetter" or "colLetter row", the function will return
- * a pair of integers representing the target.
- * 
- * If the input cannot be parsed, the function returns a pair of {-1, -1}.
- * 
- * @return A pair of integers representing the target row and column, or {-1, -1} if the input
- * could not be parsed.
- */
-pair<int,int> parseFlexibleInput() {
-    // Read a full line (consumes the newline if any) so single-token inputs like "A5"
-    // or "5A" are handled without blocking for a second token.
-    string line;
-    if (!getline(cin >> ws, line)) return {-1, -1};
-
-    // Remove commas and whitespace, then separate letters and digits
-    line.erase(remove(line.begin(), line.end(), ','), line.end());
-    string compact;
-    for (char ch : line) if (!isspace(static_cast<unsigned char>(ch))) compact.push_back(ch);
-
-    string digits, letters;
-    for (char ch : compact) {
-        if (isdigit(static_cast<unsigned char>(ch))) digits.push_back(ch);
-        else if (isalpha(static_cast<unsigned char>(ch))) letters.push_back(ch);
-    }
-
-    int row = -1, col = -1;
-    if (!digits.empty() && !letters.empty()) {
-        // Common cases: "3D" or "D3" or "3D," etc.
-        row = stoi(digits);
-        col = letterToCol(letters[0]);
-        return {row, col};
-    }
-
-    // Fallback: try to parse as two space-separated tokens
-    string token1, token2;
-    stringstream ss(compact);
-    if (ss >> token1 >> token2) {
-        if (!token1.empty() && isdigit(static_cast<unsigned char>(token1[0]))) {
-            row = stoi(token1);
-            col = letterToCol(token2[0]);
-        } else {
-            col = letterToCol(token1[0]);
-            row = stoi(token2);
-        }
-        return {row, col};
-    }
-
-    // Unrecognized input
-    return {-1, -1};
-}
-
-
+#define INSTANTIATE_BOARD(RulesT)                                                                       \
+    template struct BasicFleetSampler<RulesT>;                                                          \
+    template const BasicFleetSampler<RulesT> &fleetSampler<RulesT>(FleetBias);                          \
+    template void initializeBoard<RulesT>(char[RulesT::ROWS][RulesT::COLS]);                            \
+    template void biasedPlaceShipsOnBoard<RulesT>(char[RulesT::ROWS][RulesT::COLS]);                    \
+    template void randomlyPlaceShipsOnBoard<RulesT>(char[RulesT::ROWS][RulesT::COLS]);                  \
+    template bool checkShotIsAvailable<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int);       \
+    template int updateBoard<RulesT>(char[RulesT::ROWS][RulesT::COLS], int, int, int[]);                \
+    template bool isWinner<RulesT>(const int[]);                                                        \
+    template bool updateShipSize<RulesT>(int[], int);                                                   \
+    template bool canPlaceShip<RulesT>(const char[RulesT::ROWS][RulesT::COLS], int, int, int, bool);    \
+    template void placeShip<RulesT>(char[RulesT::ROWS][RulesT::COLS], int, int, int, char, bool);
+FOR_EACH_GAME_RULES(INSTANTIATE_BOARD)
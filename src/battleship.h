@@ -1,20 +1,21 @@
 #ifndef BATTLESHIP_H
 #define BATTLESHIP_H
 
-#include <iostream>
+// Console-free game core: nothing here may pull in iostreams, so the WASM build
+// stays small. Terminal I/O for the native CLI lives in console.h.
 #include <string>
-#include <iomanip>
 #include <cstdlib>
 #include <ctime>
-#include <limits>
 #include <cctype>
 #include <vector>
-#include <sstream>
+#include <utility>
 #include <algorithm>
+#include <cstdint>
+#include "Rules.h"
 
 using namespace std;
 
-// Global constants
+// Global constants: the standard game (StandardRules in Rules.h)
 const int NUM_ROWS = 10;
 const int NUM_COLS = 10;
 const int NUM_SHIPS = 5;
@@ -24,10 +25,14 @@ const int pTimeout = 0;
 const string SHIP_NAMES[]   = {"carrier", "battleship", "cruiser", "submarine", "destroyer"};
 const char   SHIP_SYMBOLS[] = {'c', 'b', 'r', 's', 'd'};
 const int    SHIP_SIZES[]   = {5, 4, 3, 3, 2};
+static_assert(StandardRules::ROWS == NUM_ROWS && StandardRules::COLS == NUM_COLS &&
+              StandardRules::SHIPS == NUM_SHIPS, "StandardRules must match the global constants");
 
 // Hit and miss markers
 const char HIT = 'X';
 const char MISS = 'm';
+// AI views only: a hit already explained by a sunk ship (blocks placements like a miss)
+const char SUNK = '#';
 
 enum PlayerType { HUMAN, COMPUTER };
 
@@ -40,41 +45,200 @@ struct Stats {
     bool won = false;
 };
 
-struct TargetState {
+// One board cell by row and column
+struct BoardCell {
+    int8_t row;
+    int8_t col;
+};
+
+// Insertion-ordered set of target cells held inline (no heap), so TargetState and
+// everything embedding it stays trivially copyable. Holds every cell at most once.
+template <int CELLS>
+struct BasicCellQueue {
+    BoardCell cells[CELLS];
+    int count = 0;
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    void clear() { count = 0; }
+    const BoardCell *begin() const { return cells; }
+    const BoardCell *end() const { return cells + count; }
+    bool contains(int r, int c) const {
+        for (int i = 0; i < count; ++i) if (cells[i].row == r && cells[i].col == c) return true;
+        return false;
+    }
+    // Appends (r, c) unless it is already queued
+    void push(int r, int c) {
+        if (!contains(r, c)) cells[count++] = BoardCell{static_cast<int8_t>(r), static_cast<int8_t>(c)};
+    }
+    // Removes (r, c), keeping the order of the rest
+    void remove(int r, int c) {
+        int k = 0;
+        for (int i = 0; i < count; ++i)
+            if (cells[i].row != r || cells[i].col != c) cells[k++] = cells[i];
+        count = k;
+    }
+};
+typedef BasicCellQueue<NUM_ROWS * NUM_COLS> CellQueue;
+
+template <class RulesT>
+struct BasicTargetState {
     bool active = false;
     int lastHitRow = -1;
     int lastHitCol = -1;
     bool oriented = false;
     int orientation = 0; // 0 none, 1 horizontal, 2 vertical
-    std::vector<std::pair<int,int>> queue;
+    BasicCellQueue<RulesT::CELLS> queue;
+};
+typedef BasicTargetState<StandardRules> TargetState;
+
+// Set of board cells, bit (row * cols + col)
+template <int CELLS>
+struct BasicBitboard {
+    static const int WORDS = (CELLS + 63) / 64;
+    uint64_t w[WORDS] = {};
+
+    void set(int cell) { w[cell >> 6] |= 1ULL << (cell & 63); }
+    bool test(int cell) const { return (w[cell >> 6] >> (cell & 63)) & 1; }
+    void clear() { for (int i = 0; i < WORDS; ++i) w[i] = 0; }
+    bool intersects(const BasicBitboard &o) const {
+        uint64_t any = 0;
+        for (int i = 0; i < WORDS; ++i) any |= w[i] & o.w[i];
+        return any != 0;
+    }
+    // True when every cell of this set is also in o
+    bool coveredBy(const BasicBitboard &o) const {
+        uint64_t outside = 0;
+        for (int i = 0; i < WORDS; ++i) outside |= w[i] & ~o.w[i];
+        return outside == 0;
+    }
+    BasicBitboard &operator|=(const BasicBitboard &o) { for (int i = 0; i < WORDS; ++i) w[i] |= o.w[i]; return *this; }
+    BasicBitboard &operator&=(const BasicBitboard &o) { for (int i = 0; i < WORDS; ++i) w[i] &= o.w[i]; return *this; }
+};
+typedef BasicBitboard<NUM_ROWS * NUM_COLS> Bitboard;
+
+// Seedable game RNG (splitmix64). Every random decision in the engine draws from
+// the calling thread's active generator, so a game is reproducible from its seed.
+struct GameRng {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    void seed(uint64_t s) { state = s; }
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    int below(int n) { return static_cast<int>((next() >> 32) % static_cast<uint64_t>(n)); }
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
 };
 
+// Active generator for this thread (a thread-local default unless a scope is installed)
+GameRng &gameRng();
+
+// Installs `rng` as the active generator for the current thread until destroyed
+struct GameRngScope {
+    explicit GameRngScope(GameRng &rng);
+    ~GameRngScope();
+    GameRng *previous;
+};
+
+// Per-game seed derived from a sweep's master seed and the game's global index
+uint64_t gameSeed(uint64_t masterSeed, long long gameIndex);
+
+// One fleet as an index per ship into FleetSampler's placement list for that ship.
+// The lists are in the same order for every sampler, so any sampler decodes any layout.
+template <class RulesT>
+struct BasicFleetLayout {
+    // Placement lists hold at most 2 * CELLS entries
+    typedef typename std::conditional<(2 * RulesT::CELLS <= 256), uint8_t, uint16_t>::type Index;
+    Index placement[RulesT::SHIPS];
+};
+typedef BasicFleetLayout<StandardRules> FleetLayout;
+
+// Placement weightings: start cells weighted toward the center (generatePlacementWeights),
+// all alike, or toward the edges and corners (the reverse of the center bias the AI's
+// blank-board prior leans on)
+enum FleetBias { FLEET_CENTER = 0, FLEET_UNIFORM = 1, FLEET_EDGE = 2 };
+
+// Fleet layout sampler. Places ship after ship, each at a legal placement drawn with
+// probability proportional to the weight of its start cell (both orientations alike),
+// which is the distribution of retrying a weighted start cell and a coin-flip
+// orientation until the ship fits. Every ship has its in-bounds placements listed
+// with their cell masks and an alias table over their weights: a draw costs two RNG
+// calls and one mask test. After ALIAS_TRIES draws that overlap earlier ships, one
+// pass over the list draws among the legal placements directly, so a fleet takes
+// bounded time and no allocation. Tables are built once and only read afterwards.
+template <class RulesT>
+struct BasicFleetSampler {
+    static const int ROWS = RulesT::ROWS, COLS = RulesT::COLS;
+    static const int MAX_PLACEMENTS = 2 * RulesT::CELLS;
+    static const int ALIAS_TRIES = 8;
+
+    struct Placement {
+        BasicBitboard<RulesT::CELLS> cells;
+        int8_t row, col;
+        bool horizontal;
+    };
+    struct ShipTable {
+        Placement placements[MAX_PLACEMENTS];
+        double weight[MAX_PLACEMENTS];
+        double accept[MAX_PLACEMENTS];      // alias table: keep i with this probability,
+        uint16_t alias[MAX_PLACEMENTS];     // otherwise take alias[i]
+        int count = 0;
+    };
+    ShipTable ships[RulesT::SHIPS];
+
+    explicit BasicFleetSampler(const double cellWeights[ROWS][COLS]);
+    // Places the whole fleet around whatever the board already holds, drawing from
+    // gameRng(); the chosen placements go to `layout` when given
+    void sample(char board[ROWS][COLS], BasicFleetLayout<RulesT> *layout = nullptr) const;
+    // Places a recorded layout. Leaves the board untouched and returns false when an
+    // index is out of range or a ship would overlap anything already on the board.
+    bool place(char board[ROWS][COLS], const BasicFleetLayout<RulesT> &layout) const;
+};
+typedef BasicFleetSampler<StandardRules> FleetSampler;
+static_assert(FleetSampler::MAX_PLACEMENTS <= 256 && sizeof(FleetLayout) == NUM_SHIPS,
+              "standard placement indices are stored as bytes");
+
+// Shared sampler for a weighting (built on first use)
+template <class RulesT = StandardRules>
+const BasicFleetSampler<RulesT> &fleetSampler(FleetBias bias);
+
 // Utility
 // These are removed for WASM - no console interaction
 // void pauseMs(int ms);
 // void clearScreen();
 
-// Core functions
-void welcomeScreen();
-void initializeBoard(char board[NUM_ROWS][NUM_COLS]);
-void displayBoard(const char board[NUM_ROWS][NUM_COLS], bool showShips);
-void biasedPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]);
-void manuallyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]);
-void randomlyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]);
+// Core functions. Board functions are templates on a Rules type (Rules.h); the
+// default is the standard game.
+template <class RulesT = StandardRules>
+void initializeBoard(char board[RulesT::ROWS][RulesT::COLS]);
+template <class RulesT = StandardRules>
+void biasedPlaceShipsOnBoard(char board[RulesT::ROWS][RulesT::COLS]);
+template <class RulesT = StandardRules>
+void randomlyPlaceShipsOnBoard(char board[RulesT::ROWS][RulesT::COLS]);
 int  selectWhoStartsFirst();
-bool checkShotIsAvailable(const char board[NUM_ROWS][NUM_COLS], int row, int col);
-int  updateBoard(char board[NUM_ROWS][NUM_COLS], int row, int col, int shipSizes[]);
+template <class RulesT = StandardRules>
+bool checkShotIsAvailable(const char board[RulesT::ROWS][RulesT::COLS], int row, int col);
+template <class RulesT = StandardRules>
+int  updateBoard(char board[RulesT::ROWS][RulesT::COLS], int row, int col, int shipSizes[]);
+template <class RulesT = StandardRules>
 bool isWinner(const int shipSizes[]);
 // outputCurrentMove removed for WASM - no file I/O
+template <class RulesT = StandardRules>
 bool updateShipSize(int shipSizes[], int shipIndex);
 // outputStats removed for WASM - no file I/O
-pair<int,int> getMove(PlayerType type, const char board[NUM_ROWS][NUM_COLS]);
-pair<int,int> parseFlexibleInput();
 
 // Helpers
-bool canPlaceShip(const char board[NUM_ROWS][NUM_COLS], int row, int col, int size, bool horizontal);
-void placeShip(char board[NUM_ROWS][NUM_COLS], int row, int col, int size, char symbol, bool horizontal);
-bool isShipSymbol(char ch);
+template <class RulesT = StandardRules>
+bool canPlaceShip(const char board[RulesT::ROWS][RulesT::COLS], int row, int col, int size, bool horizontal);
+template <class RulesT = StandardRules>
+void placeShip(char board[RulesT::ROWS][RulesT::COLS], int row, int col, int size, char symbol, bool horizontal);
+// True for the symbol of any ship of any fleet (FLEET_SYMBOLS)
+inline bool isShipSymbol(char ch) {
+    return ch >= 'a' && ch <= 'z' && ((FLEET_SYMBOL_MASK >> (ch - 'a')) & 1);
+}
 
 // Conversion helpers
 int  letterToCol(char colChar);
@@ -0,0 +1,161 @@
+#include "console.h"
+
+void welcomeScreen() {
+    cout << "***** Welcome to Battleship! *****\n\n";
+    cout << "Rules of the Game:\n";
+    cout << "1. Player1 is you and Player2 is the computer.\n";
+    cout << "2. Columns are A–J, rows are 0-9.\n";
+    cout << "3. Ships: carrier(5), battleship(4), cruiser(3), submarine(3), destroyer(2).\n";
+    cout << "4. '*' marks a hit; 'm' marks a miss; you cannot shoot the same cell twice.\n";
+    cout << "5. First to sink all ships wins.\n\n";
+    cout << "Press Enter to start...";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+}
+
+/**
+ * Manually place all ships on the board. The user is prompted to choose between manual and random placement.
+ * If the user chooses manual placement, they are prompted to enter the start row and column for each ship,
+ * as well as the orientation (horizontal or vertical). The program checks for invalid inputs and overlap
+ * with existing ships. If the user chooses random placement, the randomlyPlaceShipsOnBoard function is called.
+ */
+void manuallyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]) {
+    cout << "\n1. Manual placement\n2. Random placement\nChoice: ";
+    int choice; cin >> choice;
+    if (choice == 2) { randomlyPlaceShipsOnBoard(board); return; }
+
+    for (int i = 0; i < NUM_SHIPS; ++i) {
+        bool placed = false;
+        while (!placed) {
+            cout << "Place " << SHIP_NAMES[i] << " (size " << SHIP_SIZES[i] << ")\n";
+            cout << "Enter start row and column (e.g. 3 D or D 3): ";
+            auto [row, col] = parseFlexibleInput();
+
+            cout << "Orientation [0=H,1=V]: ";
+            int o; cin >> o; bool horiz = (o == 0);
+
+            if (row < 0 || row >= NUM_ROWS || col < 0 || col >= NUM_COLS) { cout << "Invalid.\n"; continue; }
+            if (!canPlaceShip(board, row, col, SHIP_SIZES[i], horiz)) { cout << "Overlap/out of bounds.\n"; continue; }
+
+            placeShip(board, row, col, SHIP_SIZES[i], SHIP_SYMBOLS[i], horiz);
+            placed = true;
+            // clearScreen removed for WASM
+            cout << "Player1's Board:\n\n";
+            displayBoard(board, true);
+        }
+    }
+}
+
+/**
+ * Displays the board in a human-readable format.
+ * The board is displayed as a grid of characters, with row labels on the left and column labels on top.
+ * If showShips is false, ship symbols are replaced with '-'.
+ * @param board The board to display.
+ * @param showShips Whether to show ship symbols or not.
+ */
+void displayBoard(const char board[NUM_ROWS][NUM_COLS], bool showShips) {
+    // Print column labels
+    cout << "   ";
+    for (int c = 0; c < NUM_COLS; ++c){
+        cout << static_cast<char>('A' + c) << " ";
+    }
+    cout << "\n";
+
+    // Print board
+    for (int r = 0; r < NUM_ROWS; ++r) {
+        cout << setw(2) << r << " ";
+        for (int c = 0; c < NUM_COLS; ++c) {
+            char cell = board[r][c];
+
+        // If showShips is false, replace ship symbols with '-'
+            if (!showShips && isShipSymbol(cell)){
+                cell = '-';
+            }else{ cout << cell << " ";
+            }
+        }
+        cout << "\n";
+    }
+}
+
+/**
+ * Gets a move from the specified player.
+ * 
+ * If the player is human, prompts the user to enter a target in the format "row colLetter" or "colLetter row".
+ * If the player is a computer, randomly selects a target that is still available.
+ * 
+ * @param type The type of player (human or computer).
+ * @param board The current game board.
+ * @return A pair of integers representing the row and column of the selected target.
+ */
+pair<int,int> getMove(PlayerType type, const char board[NUM_ROWS][NUM_COLS]) {
+    if (type == HUMAN) {
+        cout << "Enter target (row colLetter or colLetter row): ";
+        auto [row, col] = parseFlexibleInput();
+        return {row, col};
+    } else {
+        int row, col;
+        do {
+            row = gameRng().below(NUM_ROWS);
+            col = gameRng().below(NUM_COLS);
+        } while (!checkShotIsAvailable(board, row, col));
+        // Console output removed for WASM
+        return {row, col};
+    }
+}
+
+/**
+ * Parses a user input string in a flexible format to extract a row and column target.
+ * 
+ * The input is expected to be a single line of text, and may contain spaces, commas, and/or
+ * letters and digits. The function removes all commas and whitespace, then separates the letters
+ * and digits.
+ * 
+ * If the input is in the format of "row colLetter" or "colLetter row", the function will return
+ * a pair of integers representing the target.
+ * 
+ * If the input cannot be parsed, the function returns a pair of {-1, -1}.
+ * 
+ * @return A pair of integers representing the target row and column, or {-1, -1} if the input
+ * could not be parsed.
+ */
+pair<int,int> parseFlexibleInput() {
+    // Read a full line (consumes the newline if any) so single-token inputs like "A5"
+    // or "5A" are handled without blocking for a second token.
+    string line;
+    if (!getline(cin >> ws, line)) return {-1, -1};
+
+    // Remove commas and whitespace, then separate letters and digits
+    line.erase(remove(line.begin(), line.end(), ','), line.end());
+    string compact;
+    for (char ch : line) if (!isspace(static_cast<unsigned char>(ch))) compact.push_back(ch);
+
+    string digits, letters;
+    for (char ch : compact) {
+        if (isdigit(static_cast<unsigned char>(ch))) digits.push_back(ch);
+        else if (isalpha(static_cast<unsigned char>(ch))) letters.push_back(ch);
+    }
+
+    int row = -1, col = -1;
+    if (!digits.empty() && !letters.empty()) {
+        // Common cases: "3D" or "D3" or "3D," etc.
+        row = stoi(digits);
+        col = letterToCol(letters[0]);
+        return {row, col};
+    }
+
+    // Fallback: try to parse as two space-separated tokens
+    string token1, token2;
+    stringstream ss(compact);
+    if (ss >> token1 >> token2) {
+        if (!token1.empty() && isdigit(static_cast<unsigned char>(token1[0]))) {
+            row = stoi(token1);
+            col = letterToCol(token2[0]);
+        } else {
+            col = letterToCol(token1[0]);
+            row = stoi(token2);
+        }
+        return {row, col};
+    }
+
+    // Unrecognized input
+    return {-1, -1};
+}
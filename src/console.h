@@ -0,0 +1,17 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+// Terminal front end for the native CLI (main.cpp). Not part of the WASM build.
+#include "battleship.h"
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+void welcomeScreen();
+void displayBoard(const char board[NUM_ROWS][NUM_COLS], bool showShips);
+void manuallyPlaceShipsOnBoard(char board[NUM_ROWS][NUM_COLS]);
+pair<int,int> getMove(PlayerType type, const char board[NUM_ROWS][NUM_COLS]);
+pair<int,int> parseFlexibleInput();
+
+#endif
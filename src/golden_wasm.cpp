@@ -0,0 +1,44 @@
+#include "Golden.h"
+#ifdef BATTLESHIP_THREADS
+#include "WorkerPool.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Golden check for the WASM builds, run under node with the host filesystem
+// (scripts/golden_check.sh builds it with -s NODERAWFS=1):
+//   node golden-wasm.js <golden file> [pool size]
+// Replays the corpus on the scalar and batch engines like `tuner golden check`;
+// threaded builds size the Monte Carlo pool from the second argument.
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: golden-wasm <golden file> [pool size]\n");
+        return 1;
+    }
+#ifdef BATTLESHIP_THREADS
+    if (argc > 2) WorkerPool::setSharedSize(std::atoi(argv[2]));
+#endif
+    std::string text;
+    if (FILE *f = std::fopen(argv[1], "rb")) {
+        char buf[65536];
+        for (size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0; ) text.append(buf, n);
+        std::fclose(f);
+    }
+    GoldenCorpus golden;
+    if (!goldenFromText(text, golden)) {
+        std::fprintf(stderr, "cannot read golden file %s\n", argv[1]);
+        return 1;
+    }
+    int failed = 0;
+    for (GoldenBackend backend : {GOLDEN_SCALAR, GOLDEN_BATCH}) {
+        std::vector<GoldenGame> got;
+        playGoldenBlocks(golden, 0, static_cast<int>(goldenBlocks(golden)), backend, got);
+        GoldenReport r = compareGolden(golden, got, backend == GOLDEN_SCALAR);
+        std::printf("%s: %lld games, %lld mismatched", backend == GOLDEN_SCALAR ? "scalar" : "batch", r.games,
+                    r.mismatched);
+        std::printf(r.mismatched ? " FAIL: %s\n" : " ok\n", r.firstMismatch.c_str());
+        failed += r.mismatched > 0;
+    }
+    return failed ? 1 : 0;
+}
@@ -1,6 +1,8 @@
 
 #include "battleship.h"
+#include "console.h"
 #include "MLforAI.h"
+#include "Metrics.h"
 #include <limits>
 #include <iomanip>
 
@@ -23,8 +25,13 @@ struct RoundResult {
     long long shotsP2 = 0;
 };
 
-RoundResult playOneRound(int mode, int round) {
+RoundResult playOneRound(int mode, int round, uint64_t masterSeed) {
     RoundResult result;
+    // Each round gets its own generator; a fresh thread's default one would
+    // replay the same game every round
+    GameRng rng;
+    rng.seed(gameSeed(masterSeed, round));
+    GameRngScope useRng(rng);
 
     // file logging removed for simpler native runs (WASM-compatible)
 
@@ -155,6 +162,7 @@ RoundResult playOneRound(int mode, int round) {
 
 int main() {
     srand(static_cast<unsigned int>(time(nullptr)));
+    const uint64_t masterSeed = static_cast<uint64_t>(time(nullptr));
     std::atomic<int> roundsCompleted(0);
 
 
@@ -171,6 +179,13 @@ int main() {
 
     std::atomic<int> p1Wins(0), p2Wins(0);
     std::atomic<long long> totalShotsP1(0), totalShotsP2(0);
+    // Winner's shot count per round; round threads record into it without locking
+    Histogram shotsToWin;
+    auto printShotsToWin = [&]() {
+        HistogramSnapshot s = shotsToWin.snapshot();
+        cout << "Shots to Win p50/p90/p99: " << s.percentile(50) << " / "
+             << s.percentile(90) << " / " << s.percentile(99) << "\n";
+    };
 
 
     if (mode == 3) {
@@ -195,6 +210,7 @@ int main() {
                  << (roundsCompleted > 0 ? (double)totalShotsP1 / roundsCompleted : 0.0) << "\n";
             cout << "Player2 Avg Shots: " 
                  << (roundsCompleted > 0 ? (double)totalShotsP2 / roundsCompleted : 0.0) << "\n";
+            printShotsToWin();
             this_thread::sleep_for(chrono::milliseconds(100)); // Default 100ms
         }
     });
@@ -206,8 +222,9 @@ int main() {
         int batchSize = min(maxThreads, totalRounds - round + 1);
 
         for (int i = 0; i < batchSize; ++i, ++round) {
-            batch.emplace_back([mode, round, &p1Wins, &p2Wins, &totalShotsP1, &totalShotsP2, &roundsCompleted]() {
-                RoundResult r = playOneRound(mode, round);
+            batch.emplace_back([mode, round, masterSeed, &p1Wins, &p2Wins, &totalShotsP1, &totalShotsP2, &roundsCompleted, &shotsToWin]() {
+                RoundResult r = playOneRound(mode, round, masterSeed);
+                shotsToWin.record(static_cast<uint64_t>(r.p1Wins ? r.shotsP1 : r.shotsP2));
                 p1Wins += r.p1Wins;
                 p2Wins += r.p2Wins;
                 totalShotsP1 += r.shotsP1;
@@ -230,7 +247,8 @@ int main() {
     cout << "Player2 Avg Shots: " << (double)totalShotsP2 / totalRounds << "\n";
 } else {
     for (int round = 1; round <= totalRounds; ++round) {
-        RoundResult r = playOneRound(mode, round);
+        RoundResult r = playOneRound(mode, round, masterSeed);
+        shotsToWin.record(static_cast<uint64_t>(r.p1Wins ? r.shotsP1 : r.shotsP2));
         p1Wins += r.p1Wins;
         p2Wins += r.p2Wins;
         totalShotsP1 += r.shotsP1;
@@ -245,6 +263,7 @@ int main() {
         cout << fixed << setprecision(2);
         cout << "Player1 Avg Shots: " << (double)totalShotsP1 / round << "\n";
         cout << "Player2 Avg Shots: " << (double)totalShotsP2 / round << "\n";
+        printShotsToWin();
         this_thread::sleep_for(chrono::milliseconds(50)); // Default 100ms
     }
 }
@@ -259,6 +278,7 @@ int main() {
          << (totalRounds > 0 ? (double)totalShotsP1 / totalRounds : 0.0) << "\n";
     cout << "Player2 Avg Shots: " 
          << (totalRounds > 0 ? (double)totalShotsP2 / totalRounds : 0.0) << "\n";
+    printShotsToWin();
 
     return 0;
 }
@@ -0,0 +1,53 @@
+#include "simd_kernels.h"
+#include <cstring>
+
+// BATTLESHIP_SCALAR_KERNELS forces the portable loops (the golden harness's reference build)
+#if defined(__wasm_simd128__) && !defined(BATTLESHIP_SCALAR_KERNELS)
+#define KERNELS_SIMD128 1
+#include <wasm_simd128.h>
+#elif defined(__SSE2__) && !defined(BATTLESHIP_SCALAR_KERNELS)
+#define KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(KERNELS_SIMD128) || defined(KERNELS_SSE2)
+// Bit k set where the 16 bytes at p equal ch
+static inline uint32_t byteMask16(const char *p, char ch) {
+#if defined(KERNELS_SIMD128)
+    return static_cast<uint32_t>(wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(p), wasm_i8x16_splat(ch))));
+#else
+    __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi8(ch));
+    return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+#endif
+}
+#endif
+
+void rowMasksOf(const char *cells, int rows, int cols, char ch, uint32_t out[]) {
+#if defined(KERNELS_SIMD128) || defined(KERNELS_SSE2)
+    const int total = rows * cols;
+    const uint32_t keep = cols < 32 ? (1u << cols) - 1 : ~0u;
+    for (int r = 0; r < rows; ++r) {
+        const char *row = cells + r * cols;
+        uint32_t m = 0;
+        for (int half = 0; half * 16 < cols; ++half) {
+            const int at = r * cols + half * 16;
+            if (at + 16 <= total) {
+                m |= byteMask16(row + half * 16, ch) << (half * 16);
+            } else {
+                // The board's last bytes: copy them so the load stays inside it
+                alignas(16) char tail[16] = {0};
+                std::memcpy(tail, row + half * 16, total - at);
+                m |= byteMask16(tail, ch) << (half * 16);
+            }
+        }
+        out[r] = m & keep;
+    }
+#else
+    for (int r = 0; r < rows; ++r) {
+        uint32_t m = 0;
+        for (int c = 0; c < cols; ++c)
+            if (cells[r * cols + c] == ch) m |= 1u << c;
+        out[r] = m;
+    }
+#endif
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include "Rules.h"
+
+// Bitmask kernels for the probability hot paths.
+// Row masks come from 16-lane byte compares (one per 16 columns of a row) when built with
+// -msimd128 (WASM SIMD128) or SSE2, and from a scalar loop otherwise or with
+// -DBATTLESHIP_SCALAR_KERNELS.
+
+// out[r] bit c set where cells[r * cols + c] == ch, for rows of at most 32 columns
+void rowMasksOf(const char *cells, int rows, int cols, char ch, uint32_t out[]);
+
+// Per-row and per-column masks of cells equal to ch (cols[c] bit r <=> view[r][c] == ch).
+// RulesT is a Rules type (Rules.h).
+template <class RulesT>
+void boardMasks(const char view[RulesT::ROWS][RulesT::COLS], char ch, typename RulesT::LineMask rows[RulesT::ROWS],
+                typename RulesT::LineMask cols[RulesT::COLS]) {
+    typedef typename RulesT::LineMask Mask;
+    uint32_t m32[RulesT::ROWS];
+    rowMasksOf(view[0], RulesT::ROWS, RulesT::COLS, ch, m32);
+    for (int c = 0; c < RulesT::COLS; ++c) cols[c] = 0;
+    for (int r = 0; r < RulesT::ROWS; ++r) {
+        rows[r] = static_cast<Mask>(m32[r]);
+        for (uint32_t m = rows[r]; m; m &= m - 1) cols[__builtin_ctz(m)] |= static_cast<Mask>(Mask(1) << r);
+    }
+}
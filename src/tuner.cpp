@@ -1,5 +1,18 @@
 #include "Tournament.h"
+#include "BatchTournament.h"
 #include "MLforAI.h"
+#include "Replay.h"
+#include "ResultStore.h"
+#include "LayoutCorpus.h"
+#include "Distill.h"
+#include "FeatureExport.h"
+#include "MoveServer.h"
+#include "Golden.h"
+#include "RulesKernels.h"
+#include "Metrics.h"
+#ifdef BATTLESHIP_THREADS
+#include "WorkerPool.h"
+#endif
 #include <iostream>
 #include <vector>
 #include <iomanip>
@@ -7,7 +20,13 @@
 #include <ctime>
 #include <thread>
 #include <atomic>
+#include <memory>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <fstream>
 
 using namespace std;
 
@@ -25,22 +44,693 @@ static vector<double> parseRange(const string &spec, double defStart, double def
     return out;
 }
 
-// Worker: run `games` tournaments and accumulate shot totals
-static void runGamesWorker(int games, atomic<long long> &accShotsP1, atomic<long long> &accShotsP2) {
-    Tournament t;
-    t.start(3, games);
-    while (!t.done()) t.tick();
-    accShotsP1 += t.shotsP1Accum;
-    accShotsP2 += t.shotsP2Accum;
+// What every block of a sweep is played with
+struct SweepConfig {
+    long long totalGames = 0;
+    int blockGames = SWEEP_BLOCK_GAMES;
+    uint64_t seed = 0;
+    double budgetMs = -1.0;
+    const LayoutCorpus *corpus = nullptr;
+    const PolicyModel *policy = nullptr;    // player 1's distilled policy
+    bool learnPrior = false;                // each block learns a placement prior
+};
+
+// Worker: claim blocks of the sweep until none are left and record each game's shots.
+// Block b covers games [b*blockGames, (b+1)*blockGames) and is played as one
+// Tournament seeded from (seed, first game), so results do not depend on threads.
+static void runGamesWorker(const vector<long long> &blocks, const SweepConfig &cfg,
+                           atomic<size_t> &nextBlock, vector<GameShots> &out, atomic<long long> *tierAcc) {
+    for (;;) {
+        size_t i = nextBlock++;
+        if (i >= blocks.size()) break;
+        long long first = blocks[i] * cfg.blockGames;
+        int n = static_cast<int>(min<long long>(cfg.blockGames, cfg.totalGames - first));
+        Tournament t;
+        // Headless: nobody renders the live maps, and moves rebuild their own
+        t.current.liveMaps = false;
+        t.moveBudgetMs = cfg.budgetMs;
+        t.layouts = cfg.corpus->layouts;
+        t.layoutCount = cfg.corpus->count;
+        t.policy[0] = cfg.policy;
+        t.learnPrior = cfg.learnPrior;
+        t.start(3, n, cfg.seed, first);
+        long long p1 = 0, p2 = 0;
+        int finished = 0;
+        while (!t.done()) {
+            t.tick();
+            if (t.currentRoundIdx > finished) {
+                out[first + finished] = { static_cast<uint16_t>(t.shotsP1Accum - p1),
+                                          static_cast<uint16_t>(t.shotsP2Accum - p2) };
+                p1 = t.shotsP1Accum;
+                p2 = t.shotsP2Accum;
+                finished = t.currentRoundIdx;
+            }
+        }
+        for (int k = 0; k < 3; ++k) tierAcc[k] += t.tierAccum[k];
+    }
 }
 
-int main(int argc, char** argv) {
-    srand(static_cast<unsigned int>(time(nullptr)));
+// engine=batch worker: keeps up to BATCH_LANES blocks in flight in one
+// BatchTournament, handing a lane the next block as soon as its block ends.
+// Every block plays the same games as in runGamesWorker.
+static void runGamesBatchWorker(const vector<long long> &blocks, const SweepConfig &cfg,
+                                atomic<size_t> &nextBlock, vector<GameShots> &out) {
+    unique_ptr<BatchTournament> bt(new BatchTournament);
+    bt->layouts = cfg.corpus->layouts;
+    bt->layoutCount = cfg.corpus->count;
+    bt->policy[0] = cfg.policy;
+    bt->learnPrior = cfg.learnPrior;
+    long long first[BATCH_LANES] = {0};
+    int finished[BATCH_LANES] = {0};
+    bool more = true;
+    for (;;) {
+        for (int l = 0; l < BATCH_LANES && more; ++l) {
+            if (bt->busy[l]) continue;
+            size_t i = nextBlock++;
+            if (i >= blocks.size()) { more = false; break; }
+            first[l] = blocks[i] * cfg.blockGames;
+            finished[l] = 0;
+            bt->startLane(l, static_cast<int>(min<long long>(cfg.blockGames, cfg.totalGames - first[l])),
+                          cfg.seed, first[l]);
+        }
+        if (bt->busyLanes() == 0) break;
+        TickEvent ev[BATCH_LANES];
+        bt->step(ev);
+        for (int l = 0; l < BATCH_LANES; ++l)
+            if (ev[l].flags & TICK_ROUND_END)
+                out[first[l] + finished[l]++] = { ev[l].shotsP1, ev[l].shotsP2 };
+    }
+}
+
+static const char *CSV_HEADER =
+    "alphaEarly,placementHitMultiplier,adjHitBonus,mcBlendRatio,games,threads,p1_avg_shots,p2_avg_shots,"
+    "p1_p50,p1_p90,p1_p99,p2_p50,p2_p90,p2_p99,"
+    "move_us_p50,move_us_p90,move_us_p99,mc_us_p50,mc_us_p90,mc_us_p99";
+
+// Distributions reported next to a combo's averages: shots per game for each
+// player (exact) and, for games played in this run, AI move and Monte Carlo time
+struct ComboHists {
+    HistogramSnapshot shotsP1, shotsP2, moveNs, mcNs;
+
+    void merge(const ComboHists &o) { shotsP1.merge(o.shotsP1); shotsP2.merge(o.shotsP2); moveNs.merge(o.moveNs); mcNs.merge(o.mcNs); }
+    bool write(FILE *f) const { return shotsP1.write(f) && shotsP2.write(f) && moveNs.write(f) && mcNs.write(f); }
+    bool read(FILE *f) { return shotsP1.read(f) && shotsP2.read(f) && moveNs.read(f) && mcNs.read(f); }
+};
+
+// One CSV/summary row
+struct ComboResult {
+    double alpha, place, adj, mc;
+    long long games;
+    double p1avg, p2avg;
+    ComboHists hists;
+};
+
+static void printComboRow(const ComboResult &r, int threads) {
+    const double us = 1e-3;
+    cout << fixed << setprecision(3)
+         << r.alpha << "," << r.place << "," << r.adj << "," << r.mc << ","
+         << r.games << "," << threads << "," << r.p1avg << "," << r.p2avg;
+    for (const HistogramSnapshot *h : {&r.hists.shotsP1, &r.hists.shotsP2})
+        cout << "," << h->percentile(50) << "," << h->percentile(90) << "," << h->percentile(99);
+    for (const HistogramSnapshot *h : {&r.hists.moveNs, &r.hists.mcNs})
+        cout << "," << h->percentile(50) * us << "," << h->percentile(90) * us << "," << h->percentile(99) * us;
+    cout << endl;
+}
+
+static void writeJsonDist(FILE *f, const char *name, const HistogramSnapshot &h, double scale) {
+    fprintf(f, "\"%s\": {\"count\": %llu, \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f}",
+            name, static_cast<unsigned long long>(h.total), h.mean() * scale,
+            h.percentile(50) * scale, h.percentile(90) * scale, h.percentile(99) * scale);
+}
+
+// `summary=<path>`: the sweep's rows with full percentile data as JSON
+static bool writeSummaryJson(const string &path, uint64_t seed, long long gamesPerCombo,
+                             const vector<ComboResult> &rows) {
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f) return false;
+    fprintf(f, "{\"seed\": %llu, \"games_per_combo\": %lld, \"combos\": [",
+            static_cast<unsigned long long>(seed), gamesPerCombo);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const ComboResult &r = rows[i];
+        fprintf(f, "%s\n  {\"alphaEarly\": %.3f, \"placementHitMultiplier\": %.3f, \"adjHitBonus\": %.3f, "
+                   "\"mcBlendRatio\": %.3f, \"games\": %lld, ",
+                i ? "," : "", r.alpha, r.place, r.adj, r.mc, r.games);
+        writeJsonDist(f, "p1_shots", r.hists.shotsP1, 1.0);
+        fprintf(f, ", ");
+        writeJsonDist(f, "p2_shots", r.hists.shotsP2, 1.0);
+        fprintf(f, ", ");
+        writeJsonDist(f, "move_us", r.hists.moveNs, 1e-3);
+        fprintf(f, ", ");
+        writeJsonDist(f, "mc_us", r.hists.mcNs, 1e-3);
+        fprintf(f, "}");
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0;
+}
+
+// Partial results written by `shard=i/n` runs and combined by `tuner merge`.
+// Sums are kept as integers so the merged averages are exact; each record is
+// followed in the file by its ComboHists, so percentiles merge exactly too.
+static const char SHARD_MAGIC[4] = {'B', 'S', 'H', 'D'};
+static const uint32_t SHARD_VERSION = 2;
+// Header counts above these are treated as a corrupt file rather than allocated
+static const int32_t MAX_SHARDS = 1 << 16;
+static const int32_t MAX_SHARD_COMBOS = 1 << 24;
+
+struct ShardHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t seed;
+    int64_t totalGames;     // games per combo in the full sweep
+    int32_t blockGames;
+    int32_t shardIndex;
+    int32_t shardCount;
+    int32_t comboCount;     // combos in the full grid
+    int32_t recordCount;    // records following the header
+    int32_t threads;
+};
+
+struct ShardRecord {
+    int32_t combo;
+    int32_t pad;
+    double alpha, place, adj, mc;
+    int64_t games;
+    int64_t shotsP1;
+    int64_t shotsP2;
+};
+
+static bool writeShardFile(const string &path, const ShardHeader &h, const vector<ShardRecord> &recs,
+                           const vector<ComboHists> &hists) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && !recs.empty()) ok = fwrite(recs.data(), sizeof(ShardRecord), recs.size(), f) == recs.size();
+    for (size_t i = 0; ok && i < hists.size(); ++i) ok = hists[i].write(f);
+    return fclose(f) == 0 && ok;
+}
+
+static bool readShardFile(const string &path, ShardHeader &h, vector<ShardRecord> &recs,
+                          vector<ComboHists> &hists) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1
+              && memcmp(h.magic, SHARD_MAGIC, 4) == 0 && h.version == SHARD_VERSION
+              && h.shardCount > 0 && h.shardCount <= MAX_SHARDS
+              && h.shardIndex >= 0 && h.shardIndex < h.shardCount
+              && h.comboCount >= 0 && h.comboCount <= MAX_SHARD_COMBOS
+              && h.recordCount >= 0 && h.recordCount <= h.comboCount;
+    if (ok) {
+        recs.resize(h.recordCount);
+        hists.resize(h.recordCount);
+        if (h.recordCount > 0) ok = fread(recs.data(), sizeof(ShardRecord), recs.size(), f) == recs.size();
+        for (size_t i = 0; ok && i < hists.size(); ++i) ok = hists[i].read(f);
+    }
+    fclose(f);
+    return ok;
+}
+
+// `tuner merge a.bin b.bin ... [summary=out.json]`: combine shard files into the sweep CSV
+static int mergeShards(const vector<string> &args) {
+    vector<string> files;
+    string summaryPath;
+    for (const string &a : args) {
+        if (a.compare(0, 8, "summary=") == 0) summaryPath = a.substr(8);
+        else files.push_back(a);
+    }
+    if (files.empty()) { cerr << "merge: no shard files given" << endl; return 1; }
+    ShardHeader first{};
+    vector<ShardRecord> merged;
+    vector<ComboHists> mergedHists;
+    vector<bool> seenShard;
+    for (size_t fi = 0; fi < files.size(); ++fi) {
+        ShardHeader h{};
+        vector<ShardRecord> recs;
+        vector<ComboHists> hists;
+        if (!readShardFile(files[fi], h, recs, hists)) {
+            cerr << "merge: cannot read " << files[fi] << " (missing, truncated or not a shard file)" << endl;
+            return 1;
+        }
+        if (fi == 0) {
+            first = h;
+            merged.resize(h.comboCount);
+            mergedHists.resize(h.comboCount);
+            for (int c = 0; c < h.comboCount; ++c) { merged[c] = ShardRecord{}; merged[c].combo = -1; }
+            seenShard.assign(h.shardCount, false);
+        } else if (h.seed != first.seed || h.totalGames != first.totalGames || h.blockGames != first.blockGames
+                   || h.shardCount != first.shardCount || h.comboCount != first.comboCount) {
+            cerr << "merge: " << files[fi] << " belongs to a different sweep" << endl;
+            return 1;
+        }
+        if (seenShard[h.shardIndex]) {
+            cerr << "merge: duplicate shard " << h.shardIndex << " in " << files[fi] << endl;
+            return 1;
+        }
+        seenShard[h.shardIndex] = true;
+        for (size_t ri = 0; ri < recs.size(); ++ri) {
+            const ShardRecord &r = recs[ri];
+            if (r.combo < 0 || r.combo >= first.comboCount) continue;
+            mergedHists[r.combo].merge(hists[ri]);
+            ShardRecord &m = merged[r.combo];
+            if (m.combo < 0) { m = r; continue; }
+            m.games += r.games;
+            m.shotsP1 += r.shotsP1;
+            m.shotsP2 += r.shotsP2;
+        }
+    }
+    for (int i = 0; i < first.shardCount; ++i)
+        if (!seenShard[i]) cerr << "merge: warning: shard " << i << "/" << first.shardCount << " missing" << endl;
+
+    cout << CSV_HEADER << endl;
+    vector<ComboResult> rows;
+    for (const ShardRecord &m : merged) {
+        if (m.combo < 0) continue;
+        if (m.games != first.totalGames)
+            cerr << "merge: warning: combo " << m.combo << " has " << m.games << "/" << first.totalGames << " games" << endl;
+        ComboResult row{m.alpha, m.place, m.adj, m.mc, m.games,
+                        m.games ? double(m.shotsP1) / m.games : 0.0,
+                        m.games ? double(m.shotsP2) / m.games : 0.0,
+                        mergedHists[m.combo]};
+        printComboRow(row, first.threads);
+        rows.push_back(row);
+    }
+    if (!summaryPath.empty() && !writeSummaryJson(summaryPath, first.seed, first.totalGames, rows)) {
+        cerr << "merge: cannot write " << summaryPath << endl;
+        return 1;
+    }
+    return 0;
+}
+
+static void printMoves(const ReplayResult &r) {
+    cout << "move,player,row,col,result,sunk" << endl;
+    for (size_t i = 0; i < r.moves.size(); ++i) {
+        const ReplayMove &mv = r.moves[i];
+        cout << i << "," << (mv.player + 1) << "," << (mv.cell / NUM_COLS) << ","
+             << (mv.cell % NUM_COLS) << "," << int(mv.result) << "," << int(mv.sunk) << endl;
+    }
+}
+
+// Print what each player has observed of the opponent at the replayed position
+static void printViews(const RoundState &rs) {
+    cout << "P1 view      P2 view" << endl;
+    for (int r = 0; r < NUM_ROWS; ++r) {
+        for (int c = 0; c < NUM_COLS; ++c) {
+            char ch = rs.computerBoard[r][c];
+            cout << (ch == HIT || ch == MISS ? ch : '-');
+        }
+        cout << "   ";
+        for (int c = 0; c < NUM_COLS; ++c) {
+            char ch = rs.playerBoard[r][c];
+            cout << (ch == HIT || ch == MISS ? ch : '-');
+        }
+        cout << endl;
+    }
+}
+
+// The samplers biasedPlaceShipsOnBoard / randomlyPlaceShipsOnBoard used before
+// FleetSampler: retry a start cell (weighted or uniform) and a random orientation
+// until the ship fits. Kept only as the reference for `tuner fleetcheck`.
+static void referenceFleet(char board[NUM_ROWS][NUM_COLS], bool centerBias) {
+    double weights[NUM_ROWS][NUM_COLS];
+    generatePlacementWeights(weights);
+    for (int s = 0; s < NUM_SHIPS; ++s) {
+        for (;;) {
+            int row, col;
+            if (centerBias) {
+                auto cell = pickWeightedCell(weights);
+                row = cell.first;
+                col = cell.second;
+            } else {
+                row = gameRng().below(NUM_ROWS);
+                col = gameRng().below(NUM_COLS);
+            }
+            bool horizontal = gameRng().below(2) == 0;
+            if (canPlaceShip(board, row, col, SHIP_SIZES[s], horizontal)) {
+                placeShip(board, row, col, SHIP_SIZES[s], SHIP_SYMBOLS[s], horizontal);
+                break;
+            }
+        }
+    }
+}
+
+// Placement index of ship s on a laid-out board: 2 * start cell + (vertical ? 1 : 0)
+static int placementIndex(const char board[NUM_ROWS][NUM_COLS], int s) {
+    for (int r = 0; r < NUM_ROWS; ++r)
+        for (int c = 0; c < NUM_COLS; ++c)
+            if (board[r][c] == SHIP_SYMBOLS[s]) {
+                bool horizontal = c + 1 < NUM_COLS && board[r][c + 1] == SHIP_SYMBOLS[s];
+                return 2 * (r * NUM_COLS + c) + (horizontal ? 0 : 1);
+            }
+    return -1;
+}
 
+// `tuner fleetcheck games=<n> [seed=<s>]`: lays out n fleets with FleetSampler and n
+// with the reference sampler, for the center-biased and the uniform layouts, and
+// compares each ship's placement counts with a two-sample chi-square test. z is the
+// statistic's distance from its mean in standard deviations (normal approximation);
+// any |z| >= 4 fails the check.
+static int fleetCheck(long long fleets, uint64_t seed) {
+    cout << "layout,ship,chi2,df,z,sampler_ns,reference_ns" << endl;
+    bool ok = true;
+    for (int bias = 1; bias >= 0; --bias) {
+        vector<long long> counts[2][NUM_SHIPS];
+        uint64_t ns[2] = {0, 0};
+        for (int which = 0; which < 2; ++which) {
+            for (int s = 0; s < NUM_SHIPS; ++s) counts[which][s].assign(2 * NUM_ROWS * NUM_COLS, 0);
+            for (long long i = 0; i < fleets; ++i) {
+                GameRng rng;
+                rng.seed(gameSeed(seed + which, i));    // independent streams for the two samplers
+                GameRngScope scope(rng);
+                char board[NUM_ROWS][NUM_COLS];
+                initializeBoard(board);
+                uint64_t t0 = metricsNowNs();
+                if (which == 1) referenceFleet(board, bias != 0);
+                else if (bias) biasedPlaceShipsOnBoard(board);
+                else randomlyPlaceShipsOnBoard(board);
+                ns[which] += metricsNowNs() - t0;
+                for (int s = 0; s < NUM_SHIPS; ++s) counts[which][s][placementIndex(board, s)]++;
+            }
+        }
+        for (int s = 0; s < NUM_SHIPS; ++s) {
+            double chi2 = 0.0;
+            int df = -1;
+            for (size_t k = 0; k < counts[0][s].size(); ++k) {
+                double a = static_cast<double>(counts[0][s][k]), b = static_cast<double>(counts[1][s][k]);
+                if (a + b == 0.0) continue;
+                chi2 += (a - b) * (a - b) / (a + b);
+                df++;
+            }
+            double z = df > 0 ? (chi2 - df) / sqrt(2.0 * df) : 0.0;
+            if (fabs(z) >= 4.0) ok = false;
+            cout << (bias ? "biased" : "uniform") << ',' << SHIP_NAMES[s] << ',' << fixed << setprecision(1)
+                 << chi2 << ',' << df << ',' << setprecision(2) << z << ',' << setprecision(0)
+                 << static_cast<double>(ns[0]) / fleets << ',' << static_cast<double>(ns[1]) / fleets << endl;
+        }
+    }
+    cerr << (ok ? "fleetcheck: distributions match" : "fleetcheck: distributions differ") << endl;
+    return ok ? 0 : 1;
+}
+
+static void printDistillEpoch(int epoch, const PolicyTrainStats &st) {
+    cerr << "[epoch " << epoch << " log loss " << fixed << setprecision(4) << st.logLoss
+         << " top-cell hit rate " << setprecision(3) << st.topHitRate << "]" << endl;
+}
+
+// `tuner distill out=<model> games=<n> [seed=<s>] [threads=<t>] [epochs=<e>] [lr=<rate>]`:
+// records every position of n pipeline games, fits the policy model to them and
+// reports its loss and top-cell hit rate on the positions of n/4 fresh games, then
+// the shots to win of the pipeline and of the model on another n/4 games
+static int distillPolicy(const string &path, long long games, uint64_t seed, int blockGames, int threads,
+                         int epochs, float learningRate) {
+    if (path.empty()) { cerr << "distill needs out=<model path>" << endl; return 1; }
+    vector<PolicySample> train, test;
+    collectPolicySamples(games, seed, blockGames, threads, train);
+    collectPolicySamples(max(1LL, games / 4), seed + 1, blockGames, threads, test);
+    cerr << "[" << train.size() << " training positions, " << test.size() << " test positions]" << endl;
+
+    unique_ptr<PolicyModel> m(new PolicyModel);
+    trainPolicyModel(train, epochs, learningRate, seed, *m, printDistillEpoch);
+    PolicyTrainStats held = evaluatePolicyModel(test, *m);
+
+    cerr << "[held-out log loss " << fixed << setprecision(4) << held.logLoss
+         << " top-cell hit rate " << setprecision(3) << held.topHitRate << "]" << endl;
+
+    // Parity check on fresh games: the same boards played alone by each
+    long long evalGames = max(1LL, games / 4);
+    SoloResult pipeline = measureShotsToWin(nullptr, evalGames, seed + 2, blockGames, threads);
+    SoloResult distilled = measureShotsToWin(m.get(), evalGames, seed + 2, blockGames, threads);
+    cerr << "[shots to win over " << evalGames << " games: pipeline " << setprecision(2) << pipeline.avgShots
+         << " (" << setprecision(1) << pipeline.moveUs << " us/move p50), policy " << setprecision(2)
+         << distilled.avgShots << " (" << setprecision(1) << distilled.moveUs << " us/move p50)]" << endl;
+    if (!savePolicyModel(path, *m)) { cerr << "cannot write " << path << endl; return 1; }
+    cerr << "[model written to " << path << "; compare with: tuner policy=" << path << "]" << endl;
+    return 0;
+}
+
+// Weight sets for the move server, one per line (AI_WEIGHT_COUNT numbers in
+// AIWeights declaration order); line k is weights id k
+static bool loadWeightSets(const string &path, vector<AIWeights> &out) {
+    ifstream in(path);
+    if (!in) return false;
+    string line;
+    while (getline(in, line)) {
+        istringstream ss(line);
+        double vals[AI_WEIGHT_COUNT];
+        int n = 0;
+        while (n < AI_WEIGHT_COUNT && ss >> vals[n]) n++;
+        if (n == 0) continue;
+        if (n != AI_WEIGHT_COUNT) return false;
+        AIWeights w;
+        weightsFromArray(vals, w);
+        out.push_back(w);
+    }
+    return true;
+}
+
+// `tuner serve [socket=<path>] [window=<us>] [weights=<file>]`: serves moves until
+// interrupted (or until stdin closes when no socket is given), then prints the
+// per-request latency percentiles
+static int serveMoves(const string &socketPath, int windowUs, const string &weightsPath) {
+    MoveServerConfig cfg;
+    cfg.socketPath = socketPath;
+    cfg.windowUs = windowUs;
+    if (!weightsPath.empty() && !loadWeightSets(weightsPath, cfg.weights)) {
+        cerr << "cannot read weight sets from " << weightsPath << endl;
+        return 1;
+    }
+    cerr << "[serving on " << (socketPath.empty() ? string("stdin/stdout") : socketPath) << ", "
+         << cfg.weights.size() + 1 << " weight sets, window " << windowUs << " us]" << endl;
+    MoveServerStats stats;
+    if (!runMoveServer(cfg, stats)) { cerr << "cannot listen on " << socketPath << endl; return 1; }
+    HistogramSnapshot lat = stats.latencyNs.snapshot();
+    cerr << "[" << stats.requests << " requests from " << stats.connections << " connections in " << stats.batches
+         << " batches (" << fixed << setprecision(2) << (stats.batches ? double(stats.requests) / stats.batches : 0.0)
+         << " per batch); latency us p50 " << setprecision(1) << lat.percentile(50) / 1000.0 << " p90 "
+         << lat.percentile(90) / 1000.0 << " p99 " << lat.percentile(99) / 1000.0 << "]" << endl;
+    return 0;
+}
+
+// `tuner loadgen socket=<path> [clients=<k>] [games=<n>] [seed=<s>] [weightsId=<id>]`:
+// plays n games over k connections with every move from the server
+static int loadGenerator(const string &socketPath, int clients, long long games, uint64_t seed, int weightsId) {
+    if (socketPath.empty()) { cerr << "loadgen needs socket=<path>" << endl; return 1; }
+    LoadGenResult r = runLoadGenerator(socketPath, clients, games, seed, static_cast<uint16_t>(weightsId));
+    if (!r.ok) { cerr << "loadgen: request failed (is the server running on " << socketPath << "?)" << endl; return 1; }
+    auto us = [](const HistogramSnapshot &h, double p) { return h.percentile(p) / 1000.0; };
+    cout << "clients,games,requests,seconds,requests_per_s,avg_shots,mean_batch,"
+            "rtt_us_p50,rtt_us_p90,rtt_us_p99,server_us_p50,server_us_p90,server_us_p99\n";
+    cout << clients << "," << r.games << "," << r.requests << "," << fixed << setprecision(3) << r.seconds << ","
+         << setprecision(0) << r.requests / max(r.seconds, 1e-9) << "," << setprecision(3)
+         << (r.games ? r.shots / (2.0 * r.games) : 0.0) << ","
+         << (r.requests ? double(r.batchSum) / r.requests : 0.0) << "," << setprecision(1)
+         << us(r.roundTripNs, 50) << "," << us(r.roundTripNs, 90) << "," << us(r.roundTripNs, 99) << ","
+         << us(r.serverNs, 50) << "," << us(r.serverNs, 90) << "," << us(r.serverNs, 99) << "\n";
+    return 0;
+}
+
+// A mid-game view under RulesT: a fleet laid out uniformly at random, then each
+// cell fired at with probability shotShare
+template <class RulesT>
+static void randomRulesView(GameRng &rng, double shotShare, char view[RulesT::ROWS][RulesT::COLS]) {
+    const int R = RulesT::ROWS, C = RulesT::COLS;
+    bool ship[R][C] = {};
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        const int len = RulesT::SIZES[s];
+        for (bool placed = false; !placed; ) {
+            bool horiz = rng.below(2);
+            int r = rng.below(horiz ? R : R - len + 1), c = rng.below(horiz ? C - len + 1 : C);
+            placed = true;
+            for (int k = 0; k < len && placed; ++k) placed = !ship[horiz ? r : r + k][horiz ? c + k : c];
+            for (int k = 0; k < len && placed; ++k) ship[horiz ? r : r + k][horiz ? c + k : c] = true;
+        }
+    }
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+            view[r][c] = rng.unit() < shotShare ? (ship[r][c] ? HIT : MISS) : '-';
+}
+
+// Keeps the benchmarked kernels' results alive
+static volatile int scalingSink;
+
+// Mean time of a headless CvC game under RulesT and the winner's mean shots
+template <class RulesT>
+static void benchGames(uint64_t seed, int games, double &gameMs, double &shotsToWin) {
+    std::unique_ptr<BasicTournament<RulesT>> t(new BasicTournament<RulesT>);
+    t->current.logMoves = false;
+    t->current.liveMaps = false;
+    uint64_t t0 = metricsNowNs();
+    t->start(3, games, seed);
+    long long winnerShots = 0;
+    while (!t->done()) {
+        TickEvent ev;
+        t->step(&ev);
+        if (ev.flags & TICK_ROUND_END) winnerShots += ev.winner == 1 ? ev.shotsP1 : ev.shotsP2;
+    }
+    gameMs = (metricsNowNs() - t0) / 1e6 / games;
+    shotsToWin = double(winnerShots) / games;
+}
+
+// One CSV row of `tuner scaling`: mean cost of placement enumeration and of a
+// Monte Carlo run over the same random views and, for rule sets the engine is
+// built for (FOR_EACH_GAME_RULES), of whole games
+template <class RulesT, bool PLAYABLE>
+static void benchRules(const char *name, int views, uint64_t seed, int mcIterations) {
+    struct View { char v[RulesT::ROWS][RulesT::COLS]; };
+    vector<View> boards(views);
+    GameRng rng;
+    rng.seed(seed);
+    for (View &b : boards) randomRulesView<RulesT>(rng, 0.3, b.v);
+    int remaining[RulesT::SHIPS];
+    long long placements = 0;
+    for (int s = 0; s < RulesT::SHIPS; ++s) {
+        remaining[s] = RulesT::SIZES[s];
+        placements += RulesT::ROWS * (RulesT::COLS - remaining[s] + 1) + RulesT::COLS * (RulesT::ROWS - remaining[s] + 1);
+    }
+
+    uint64_t t0 = metricsNowNs();
+    for (const View &b : boards) {
+        int counts[RulesT::ROWS][RulesT::COLS];
+        placementCounts<RulesT>(b.v, remaining, aiWeights().placementHitMultiplier, counts);
+        scalingSink = counts[RulesT::ROWS / 2][RulesT::COLS / 2];
+    }
+    uint64_t t1 = metricsNowNs();
+    for (const View &b : boards) {
+        int counts[RulesT::ROWS][RulesT::COLS] = {};
+        monteCarloCounts<RulesT>(b.v, remaining, RulesT::SHIPS, mcIterations, rng, counts);
+        scalingSink = counts[0][0];
+    }
+    uint64_t t2 = metricsNowNs();
+    double placementUs = (t1 - t0) / 1000.0 / views, mcUs = (t2 - t1) / 1000.0 / views;
+    double gameMs = 0.0, shotsToWin = 0.0;
+    if constexpr (PLAYABLE) benchGames<RulesT>(seed, max(1, views / 100), gameMs, shotsToWin);
+    cout << name << "," << RulesT::ROWS << "," << RulesT::COLS << "," << RulesT::SHIPS << "," << RulesT::FLEET_CELLS
+         << "," << sizeof(typename RulesT::LineMask) * 8 << "," << placements << "," << fixed << setprecision(2)
+         << placementUs << "," << mcUs << "," << setprecision(1) << mcUs * 1000.0 / max(1, mcIterations) << ",";
+    if (PLAYABLE) cout << setprecision(2) << gameMs << "," << shotsToWin;
+    else cout << ",";
+    cout << "\n";
+}
+
+// `tuner scaling [views=<n>] [seed=<s>] [mcIters=<k>]`: enumeration and Monte Carlo
+// cost per view for several board sizes and fleets, each a compile-time Rules, and
+// per game (views / 100 CvC games) for the rule sets the engine plays
+static int scalingBenchmark(int views, uint64_t seed, int mcIterations) {
+    views = max(1, views);
+    cout << "rules,rows,cols,ships,fleet_cells,mask_bits,placements,placement_us,mc_us,mc_ns_per_sample,game_ms,"
+            "shots_to_win\n";
+    benchRules<Rules8x8, true>("8x8", views, seed, mcIterations);
+    benchRules<StandardRules, true>("10x10", views, seed, mcIterations);
+    benchRules<Rules12x12, true>("12x12", views, seed, mcIterations);
+    benchRules<Rules<15, 15, 5, 4, 3, 3, 2>, false>("15x15", views, seed, mcIterations);
+    benchRules<Rules15x15, true>("15x15-large-fleet", views, seed, mcIterations);
+    benchRules<Rules<20, 20, 5, 4, 3, 3, 2>, false>("20x20", views, seed, mcIterations);
+    return 0;
+}
+
+// Plays every game of a golden corpus on `backend`, with its blocks spread over
+// `threads` workers (the batch engine takes BATCH_LANES blocks at a time)
+static vector<GoldenGame> playGolden(const GoldenCorpus &spec, GoldenBackend backend, int threads) {
+    const int step = backend == GOLDEN_BATCH ? BATCH_LANES : 1;
+    const long long blocks = goldenBlocks(spec);
+    const long long claims = (blocks + step - 1) / step;
+    vector<vector<GoldenGame>> played(claims);
+    atomic<long long> next{0};
+    vector<thread> ths;
+    for (int k = 0; k < threads; ++k)
+        ths.emplace_back([&] {
+            for (long long i; (i = next++) < claims; )
+                playGoldenBlocks(spec, i * step, static_cast<int>(min<long long>(step, blocks - i * step)), backend,
+                                 played[i]);
+        });
+    for (auto &th : ths) th.join();
+    vector<GoldenGame> all;
+    for (auto &games : played)
+        for (auto &g : games) all.push_back(std::move(g));
+    return all;
+}
+
+// `tuner golden record out=<file> games=<n> seed=<s> [block=<games>] [threads=<k>] [mcIters=<m>] [prior=1]
+// [rules=10x10|8x8|12x12|15x15]` writes the reference scalar path's shots and live-map checksums, sampling at
+// least MC_PARALLEL_MIN_ITERATIONS per Monte Carlo run so the sampler splits;
+// `tuner golden check golden=<file> [threads=<k>] [pool=<p>]` replays the corpus on
+// the scalar and batch engines, on one thread and on k, and exits 1 on any mismatch
+static int goldenHarness(const string &mode, const string &path, long long games, uint64_t seed, int blockGames,
+                         int threads, int mcIterations, bool learnPrior, const string &rules) {
+    if (mode == "record") {
+        if (!isGoldenRuleSet(rules)) { cerr << "unknown rule set " << rules << endl; return 1; }
+        GoldenCorpus c;
+        c.seed = seed;
+        c.games = max(1LL, games);
+        c.blockGames = blockGames;
+        c.mcIterations = max(mcIterations, MC_PARALLEL_MIN_ITERATIONS);
+        c.learnPrior = learnPrior;
+        c.rules = rules;
+        c.played = playGolden(c, GOLDEN_SCALAR, threads);
+        ofstream out(path, ios::binary);
+        out << goldenToText(c);
+        if (!out.good()) { cerr << "cannot write " << path << endl; return 1; }
+        long long shots = 0;
+        for (const GoldenGame &g : c.played) shots += static_cast<long long>(g.shots.size());
+        cerr << "[" << c.rules << ": " << c.games << " games, " << shots << " shots, " << c.mcIterations << " Monte Carlo samples -> "
+             << path << "]" << endl;
+        return 0;
+    }
+    if (mode != "check") { cerr << "usage: tuner golden record|check ..." << endl; return 1; }
+
+    ifstream in(path, ios::binary);
+    stringstream text;
+    text << in.rdbuf();
+    GoldenCorpus golden;
+    if (!in || !goldenFromText(text.str(), golden)) { cerr << "cannot read golden file " << path << endl; return 1; }
+    vector<int> threadCounts = {1};
+    if (threads > 1) threadCounts.push_back(threads);
+    int failed = 0;
+    for (GoldenBackend backend : {GOLDEN_SCALAR, GOLDEN_BATCH})
+        for (int k : threadCounts) {
+            GoldenReport r = compareGolden(golden, playGolden(golden, backend, k), backend == GOLDEN_SCALAR);
+            cout << (backend == GOLDEN_SCALAR ? "scalar" : "batch") << " threads=" << k;
+#ifdef BATTLESHIP_THREADS
+            cout << " pool=" << WorkerPool::shared().size();
+#endif
+            cout << ": " << r.games << " games, " << r.mismatched << " mismatched"
+                 << (r.mismatched ? " FAIL: " + r.firstMismatch : string(" ok")) << endl;
+            failed += r.mismatched > 0;
+        }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
     int totalGames = 500; // default per combo
     int threads = 1;
     int online = 0;
+    int blockGames = SWEEP_BLOCK_GAMES;
+    uint64_t seed = static_cast<uint64_t>(time(nullptr));
+    long long gameIndex = 0;
+    int stopMove = -1;
+    double budgetMs = -1.0;
     string alphaSpec, placeSpec, adjSpec, mcSpec;
+    string alpha2Spec, place2Spec, adj2Spec, mc2Spec;
+    int shardIndex = 0, shardCount = 1;
+    string outPath, cacheDir, summaryPath, tracePath;
+    int profile = PROFILE_OFF;
+    string engine = "scalar";
+    string layoutsPath, biasName = "center";
+    long long fleets = 1000000;
+    string policyPath;
+    int epochs = 4;
+    float learningRate = 0.01f;
+    int mcIterations = aiWeights().mcIterations;
+    string socketPath, weightsPath;
+    int windowUs = 0, clients = 4, weightsId = 0;
+    int views = 2000;
+    string goldenPath;
+    int poolThreads = 0;
+    bool learnPrior = false;
+    string rulesName = "10x10";
+
+    // Optional subcommand: `tuner replay|diff|merge|fleetcheck|corpus|distill|features|serve|loadgen|scaling|golden ...`
+    string command;
+    if (argc > 1 && string(argv[1]).find('=') == string::npos) command = argv[1];
+    if (command == "merge") return mergeShards(vector<string>(argv + 2, argv + argc));
 
     // Simple CLI: key=value pairs
     for (int i = 1; i < argc; ++i) {
@@ -54,7 +744,123 @@ int main(int argc, char** argv) {
         else if (k=="place") placeSpec = v;
         else if (k=="adj") adjSpec = v;
         else if (k=="mc") mcSpec = v;
+        else if (k=="alpha2") alpha2Spec = v;
+        else if (k=="place2") place2Spec = v;
+        else if (k=="adj2") adj2Spec = v;
+        else if (k=="mc2") mc2Spec = v;
         else if (k=="online") online = stoi(v);
+        else if (k=="seed") seed = stoull(v);
+        else if (k=="block") blockGames = max(1, stoi(v));
+        else if (k=="game") gameIndex = stoll(v);
+        else if (k=="move") stopMove = stoi(v);
+        else if (k=="out") outPath = v;
+        else if (k=="cache") cacheDir = v;
+        else if (k=="summary") summaryPath = v;
+        else if (k=="profile") profile = stoi(v);
+        else if (k=="trace") { tracePath = v; profile = PROFILE_TRACE; }
+        else if (k=="budget") budgetMs = stod(v);
+        else if (k=="engine") engine = v;
+        else if (k=="layouts") layoutsPath = v;
+        else if (k=="bias") biasName = v;
+        else if (k=="fleets") fleets = stoll(v);
+        else if (k=="policy") policyPath = v;
+        else if (k=="epochs") epochs = stoi(v);
+        else if (k=="lr") learningRate = stof(v);
+        else if (k=="mcIters") mcIterations = max(0, stoi(v));
+        else if (k=="socket") socketPath = v;
+        else if (k=="window") windowUs = max(0, stoi(v));
+        else if (k=="weights") weightsPath = v;
+        else if (k=="clients") clients = max(1, stoi(v));
+        else if (k=="weightsId") weightsId = stoi(v);
+        else if (k=="views") views = stoi(v);
+        else if (k=="golden") goldenPath = v;
+        else if (k=="pool") poolThreads = max(1, stoi(v));
+        else if (k=="prior") learnPrior = stoi(v) != 0;
+        else if (k=="rules") rulesName = v;
+        else if (k=="shard") {
+            size_t slash = v.find('/');
+            if (slash == string::npos) { cerr << "shard must be i/n" << endl; return 1; }
+            shardIndex = stoi(v.substr(0, slash));
+            shardCount = stoi(v.substr(slash + 1));
+            if (shardCount < 1 || shardCount > MAX_SHARDS || shardIndex < 0 || shardIndex >= shardCount) {
+                cerr << "invalid shard " << v << endl;
+                return 1;
+            }
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (engine != "scalar" && engine != "batch") { cerr << "engine must be scalar or batch" << endl; return 1; }
+    if (engine == "batch" && budgetMs >= 0.0) { cerr << "engine=batch does not take a move budget" << endl; return 1; }
+    if (poolThreads > 0) {
+        // Size of the Monte Carlo worker pool, which is otherwise the hardware's
+#ifdef BATTLESHIP_THREADS
+        WorkerPool::setSharedSize(poolThreads);
+#else
+        cerr << "pool= needs a build with -DBATTLESHIP_THREADS" << endl;
+        return 1;
+#endif
+    }
+
+    if (command == "fleetcheck") return fleetCheck(max(1, totalGames), seed);
+    if (command == "corpus") {
+        // `tuner corpus out=<path> fleets=<n> [bias=center|uniform|edge] [seed=<s>]`
+        FleetBias bias = biasName == "uniform" ? FLEET_UNIFORM : biasName == "edge" ? FLEET_EDGE : FLEET_CENTER;
+        if (biasName != "center" && bias == FLEET_CENTER) { cerr << "bias must be center, uniform or edge" << endl; return 1; }
+        if (outPath.empty() || fleets < 2) { cerr << "corpus needs out=<path> and fleets >= 2" << endl; return 1; }
+        if (!writeLayoutCorpus(outPath, bias, fleets, seed)) { cerr << "cannot write " << outPath << endl; return 1; }
+        LayoutCorpus check;
+        if (!check.open(outPath)) { cerr << "cannot read back " << outPath << endl; return 1; }
+        cerr << "[" << fleets << " " << biasName << " layouts in " << outPath << ", seed " << seed
+             << ", id " << check.id() << "]" << endl;
+        return 0;
+    }
+
+    if (command == "golden") {
+        string mode = argc > 2 && string(argv[2]).find('=') == string::npos ? argv[2] : "";
+        return goldenHarness(mode, mode == "record" ? outPath : goldenPath, totalGames, seed, blockGames, threads,
+                             mcIterations, learnPrior, rulesName);
+    }
+    if (command == "scaling") return scalingBenchmark(views, seed, mcIterations);
+    if (command == "serve") return serveMoves(socketPath, windowUs, weightsPath);
+    if (command == "loadgen") return loadGenerator(socketPath, clients, totalGames, seed, weightsId);
+    if (command == "distill") return distillPolicy(outPath, totalGames, seed, blockGames, threads, epochs, learningRate);
+
+    // Optional distilled policy for player 1 (player 2 keeps the pipeline, so the
+    // p1/p2 columns compare the two on the same games)
+    unique_ptr<PolicyModel> policy;
+    if (!policyPath.empty()) {
+        policy.reset(new PolicyModel);
+        if (!loadPolicyModel(policyPath, *policy)) { cerr << "cannot read policy model " << policyPath << endl; return 1; }
+    }
+
+    // Optional layout corpus: both boards of game g come from layouts 2g and 2g + 1
+    // (wrapping around), so separate runs play on exactly the same boards
+    LayoutCorpus corpus;
+    if (!layoutsPath.empty()) {
+        if (!corpus.open(layoutsPath)) { cerr << "cannot read layout corpus " << layoutsPath << endl; return 1; }
+        if (corpus.count < 2) { cerr << "layout corpus " << layoutsPath << " holds fewer than 2 layouts" << endl; return 1; }
+        cerr << "[layouts " << layoutsPath << ": " << corpus.count << " boards, id " << corpus.id() << "]" << endl;
+    }
+
+    if (command == "features") {
+        // `tuner features out=<prefix> games=<n> [seed=<s>] [threads=<t>] [mcIters=<k>] [layouts=<file>]`
+        if (outPath.empty()) { cerr << "features needs out=<file prefix>" << endl; return 1; }
+        FeatureExportConfig fx;
+        fx.games = totalGames;
+        fx.seed = seed;
+        fx.blockGames = blockGames;
+        fx.threads = threads;
+        fx.mcIterations = mcIterations;
+        fx.layouts = corpus.layouts;
+        fx.layoutCount = corpus.count;
+        auto t0 = chrono::steady_clock::now();
+        FeatureExportResult r = exportFeatures(outPath, fx);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        if (!r.ok) { cerr << "cannot write " << outPath << ".<thread>.bsfx" << endl; return 1; }
+        cerr << "[" << r.rows << " rows (" << FEATURE_COLUMNS << " float32 columns) from " << r.moves << " moves in "
+             << outPath << ".0.bsfx.." << outPath << "." << threads - 1 << ".bsfx, " << fixed << setprecision(1)
+             << secs << " s]" << endl;
+        return 0;
     }
 
     // Default ranges
@@ -63,9 +869,62 @@ int main(int argc, char** argv) {
     auto adjs = parseRange(adjSpec, 0.2, 0.2, 0.6);
     auto mcs = parseRange(mcSpec, 0.0, 0.5, 0.5);
 
+    if (command == "replay" || command == "diff") {
+        // Regenerate one game of a sweep: seed=<master> game=<index> [move=<n>] [block=<games>] [prior=1]
+        AIWeights wa = gAIWeights;
+        wa.globalAlphaEarly = alphas[0];
+        wa.placementHitMultiplier = places[0];
+        wa.adjHitBonus = adjs[0];
+        wa.mcBlendRatio = mcs[0];
+
+        ReplayResult ra;
+        replayGame(seed, gameIndex, wa, ra, stopMove, blockGames, corpus.layouts, corpus.count, learnPrior);
+
+        if (command == "replay") {
+            cout << "seed=" << seed << " game=" << gameIndex << " block=" << blockGames
+                 << " moves=" << ra.moves.size() << " p1_shots=" << ra.shotsP1
+                 << " p2_shots=" << ra.shotsP2 << " winner=" << (ra.winner + 1)
+                 << " digest=" << hex << ra.digest << dec << endl;
+            printMoves(ra);
+            if (stopMove >= 0) printViews(ra.state);
+            return 0;
+        }
+
+        // Diff: same game with a second weight vector (alpha2/place2/adj2/mc2 override A)
+        AIWeights wb = wa;
+        if (!alpha2Spec.empty()) wb.globalAlphaEarly = stod(alpha2Spec);
+        if (!place2Spec.empty()) wb.placementHitMultiplier = stod(place2Spec);
+        if (!adj2Spec.empty()) wb.adjHitBonus = stod(adj2Spec);
+        if (!mc2Spec.empty()) wb.mcBlendRatio = stod(mc2Spec);
+
+        ReplayResult rb;
+        replayGame(seed, gameIndex, wb, rb, stopMove, blockGames, corpus.layouts, corpus.count, learnPrior);
+        int div = firstDivergence(ra.moves, rb.moves);
+        cout << "seed=" << seed << " game=" << gameIndex << endl;
+        cout << "A: moves=" << ra.moves.size() << " p1_shots=" << ra.shotsP1 << " p2_shots=" << ra.shotsP2
+             << " digest=" << hex << ra.digest << dec << endl;
+        cout << "B: moves=" << rb.moves.size() << " p1_shots=" << rb.shotsP1 << " p2_shots=" << rb.shotsP2
+             << " digest=" << hex << rb.digest << dec << endl;
+        if (div < 0) { cout << "identical move sequences" << endl; return 0; }
+        cout << "first divergence at move " << div << endl;
+        cout << "move,A_player,A_row,A_col,B_player,B_row,B_col" << endl;
+        size_t n = max(ra.moves.size(), rb.moves.size());
+        for (size_t i = div; i < n; ++i) {
+            cout << i;
+            for (const ReplayResult *r : {&ra, &rb}) {
+                if (i < r->moves.size()) {
+                    const ReplayMove &mv = r->moves[i];
+                    cout << "," << (mv.player + 1) << "," << (mv.cell / NUM_COLS) << "," << (mv.cell % NUM_COLS);
+                } else cout << ",,,";
+            }
+            cout << endl;
+        }
+        return 0;
+    }
+
     if (online) {
         // Online learning mode: update weights after each game
-        cout << "[Online learning mode enabled]" << endl;
+        cout << "[Online learning mode enabled, seed " << seed << "]" << endl;
         // Start with initial weights (first in range)
         AIWeights w = gAIWeights;
         w.globalAlphaEarly = alphas[0];
@@ -76,25 +935,29 @@ int main(int argc, char** argv) {
 
         double lr = 0.05; // learning rate
         double bestAvg = 1e9;
+        // Nudge directions come from their own stream, so a run is reproducible from seed=
+        GameRng nudges;
+        nudges.seed(gameSeed(~seed, 0));
+        auto sign = [&nudges] { return nudges.below(2) ? 1 : -1; };
         for (int g = 0; g < totalGames; ++g) {
             Tournament t;
-            t.start(3, 1);
+            t.start(3, 1, seed, g);
             while (!t.done()) t.tick();
             double avgShots = 0.5 * (t.shotsP1Accum + t.shotsP2Accum);
             // Simple reward: if avgShots < bestAvg, reinforce weights
             if (avgShots < bestAvg) {
                 bestAvg = avgShots;
                 // Reward: nudge weights in current direction
-                w.globalAlphaEarly += lr * ((rand()%2) ? 1 : -1) * 0.01;
-                w.placementHitMultiplier += lr * ((rand()%2) ? 1 : -1) * 0.05;
-                w.adjHitBonus += lr * ((rand()%2) ? 1 : -1) * 0.02;
-                w.mcBlendRatio += lr * ((rand()%2) ? 1 : -1) * 0.01;
+                w.globalAlphaEarly += lr * sign() * 0.01;
+                w.placementHitMultiplier += lr * sign() * 0.05;
+                w.adjHitBonus += lr * sign() * 0.02;
+                w.mcBlendRatio += lr * sign() * 0.01;
             } else {
                 // Penalize: nudge weights in opposite direction
-                w.globalAlphaEarly -= lr * ((rand()%2) ? 1 : -1) * 0.01;
-                w.placementHitMultiplier -= lr * ((rand()%2) ? 1 : -1) * 0.05;
-                w.adjHitBonus -= lr * ((rand()%2) ? 1 : -1) * 0.02;
-                w.mcBlendRatio -= lr * ((rand()%2) ? 1 : -1) * 0.01;
+                w.globalAlphaEarly -= lr * sign() * 0.01;
+                w.placementHitMultiplier -= lr * sign() * 0.05;
+                w.adjHitBonus -= lr * sign() * 0.02;
+                w.mcBlendRatio -= lr * sign() * 0.01;
             }
             // Clamp weights to reasonable ranges
             w.globalAlphaEarly = max(0.5, min(0.9, w.globalAlphaEarly));
@@ -120,9 +983,45 @@ int main(int argc, char** argv) {
         return 0;
     }
 
-    // Default: sweep mode
-    cout << "alphaEarly,placementHitMultiplier,adjHitBonus,mcBlendRatio,games,threads,p1_avg_shots,p2_avg_shots" << endl;
+    // Default: sweep mode (the seed makes every game replayable with `tuner replay`)
+    cerr << "[seed " << seed << " block " << blockGames << "]" << endl;
+
+    // Work units are (combo, block) pairs numbered combo-major; shard i of n plays
+    // the units with index % n == i and writes partial sums instead of the CSV.
+    bool sharded = shardCount > 1 || !outPath.empty();
+    long long blocksPerCombo = (totalGames + blockGames - 1) / blockGames;
+    vector<ShardRecord> records;
+    vector<ComboHists> recordHists;
+    vector<ComboResult> rows;
+
+    // Move and Monte Carlo timings for the combo being played
+    EngineMetrics metrics;
+    setEngineMetrics(&metrics);
+    // Per-phase timers (profile=1 counters, profile=2 or trace=<path> adds events)
+    setProfileMode(profile);
+
+    // Optional results cache: only games beyond what an entry already holds are played
+    ResultStore store;
+    // Without a build hash every engine version would share one key, so a dev build never uses the cache
+    const bool devBuild = string(ENGINE_BUILD_HASH) == "dev";
+    bool useCache = !cacheDir.empty() && !sharded && budgetMs < 0.0 && !policy && !devBuild;
+    if (!cacheDir.empty() && devBuild)
+        cerr << "[cache is ignored: built without -DENGINE_BUILD_HASH, so cached results could be stale]" << endl;
+    else if (!cacheDir.empty() && !useCache)
+        cerr << "[cache is ignored for sharded, time-budgeted or policy runs]" << endl;
+    if (useCache && !store.open(cacheDir)) { cerr << "cannot open cache " << cacheDir << endl; return 1; }
+    if (!sharded) cout << CSV_HEADER << endl;
+
+    SweepConfig sweep;
+    sweep.totalGames = totalGames;
+    sweep.blockGames = blockGames;
+    sweep.seed = seed;
+    sweep.budgetMs = budgetMs;
+    sweep.corpus = &corpus;
+    sweep.policy = policy ? policy.get() : nullptr;
+    sweep.learnPrior = learnPrior;
 
+    int combo = 0;
     for (double alpha : alphas) {
         for (double pm : places) {
             for (double ab : adjs) {
@@ -134,24 +1033,131 @@ int main(int argc, char** argv) {
                     w.mcBlendRatio = mb;
                     setAIWeights(w);
 
-                    // Split totalGames across threads
-                    int perThread = max(1, totalGames / threads);
-                    atomic<long long> accP1{0}, accP2{0};
+                    vector<GameShots> games(totalGames, GameShots{0, 0});
+                    long long cached = 0;
+                    ResultKey key = makeResultKey(w, seed, blockGames);
+                    if (corpus.layouts) key.engine += "+L" + corpus.id();
+                    if (learnPrior) key.engine += "+prior";
+                    if (useCache) {
+                        vector<GameShots> stored;
+                        if (!store.load(key, stored)) cerr << "[cache entry " << key.hex() << " unreadable]" << endl;
+                        cached = stored.size();
+                        copy(stored.begin(), stored.begin() + min<long long>(cached, totalGames), games.begin());
+                    }
+
+                    // Blocks still to play; a partially cached block is replayed from its start
+                    vector<long long> blocks;
+                    for (long long b = min<long long>(cached, totalGames) / blockGames; b < blocksPerCombo; ++b)
+                        if ((combo * blocksPerCombo + b) % shardCount == shardIndex) blocks.push_back(b);
+
+                    // Threads pull fixed blocks of games until the combo is covered
+                    metrics.reset();
+                    atomic<size_t> nextBlock{0};
+                    atomic<long long> tierAcc[3] = {{0}, {0}, {0}};
                     vector<thread> ths;
                     for (int t = 0; t < threads; ++t) {
-                        ths.emplace_back(runGamesWorker, perThread, std::ref(accP1), std::ref(accP2));
+                        if (engine == "batch")
+                            ths.emplace_back(runGamesBatchWorker, std::cref(blocks), std::cref(sweep),
+                                             std::ref(nextBlock), std::ref(games));
+                        else
+                            ths.emplace_back(runGamesWorker, std::cref(blocks), std::cref(sweep),
+                                             std::ref(nextBlock), std::ref(games), tierAcc);
                     }
                     for (auto &th : ths) th.join();
+                    if (budgetMs >= 0.0)
+                        cerr << "[budget " << budgetMs << "ms tiers heuristic/placement/full: " << tierAcc[0]
+                             << "/" << tierAcc[1] << "/" << tierAcc[2] << "]" << endl;
+
+                    if (useCache && cached < totalGames && !store.append(key, games, cached))
+                        cerr << "[cache write failed for " << key.hex() << "]" << endl;
 
-                    double p1avg = totalGames ? double(accP1.load())/totalGames : 0.0;
-                    double p2avg = totalGames ? double(accP2.load())/totalGames : 0.0;
-                    cout << fixed << setprecision(3)
-                         << alpha << "," << pm << "," << ab << "," << mb << ","
-                         << totalGames << "," << threads << "," << p1avg << "," << p2avg << endl;
+                    ComboHists hists;
+                    hists.moveNs = metrics.moveLatencyNs.snapshot();
+                    hists.mcNs = metrics.mcTimeNs.snapshot();
+                    Histogram shotsP1, shotsP2;
+                    long long accGames = 0, accP1 = 0, accP2 = 0;
+                    for (long long b : blocks) {
+                        for (long long g = b * blockGames; g < min<long long>((b + 1) * blockGames, totalGames); ++g) {
+                            accP1 += games[g].p1;
+                            accP2 += games[g].p2;
+                            ++accGames;
+                            if (sharded) { shotsP1.record(games[g].p1); shotsP2.record(games[g].p2); }
+                        }
+                    }
+
+                    if (sharded) {
+                        if (!blocks.empty()) {
+                            ShardRecord r{};
+                            r.combo = combo;
+                            r.alpha = alpha; r.place = pm; r.adj = ab; r.mc = mb;
+                            r.games = accGames;
+                            r.shotsP1 = accP1;
+                            r.shotsP2 = accP2;
+                            records.push_back(r);
+                            hists.shotsP1 = shotsP1.snapshot();
+                            hists.shotsP2 = shotsP2.snapshot();
+                            recordHists.push_back(hists);
+                        }
+                    } else {
+                        accP1 = accP2 = 0;
+                        for (const GameShots &g : games) {
+                            accP1 += g.p1;
+                            accP2 += g.p2;
+                            shotsP1.record(g.p1);
+                            shotsP2.record(g.p2);
+                        }
+                        hists.shotsP1 = shotsP1.snapshot();
+                        hists.shotsP2 = shotsP2.snapshot();
+                        ComboResult row{alpha, pm, ab, mb, totalGames,
+                                        totalGames ? double(accP1)/totalGames : 0.0,
+                                        totalGames ? double(accP2)/totalGames : 0.0, hists};
+                        printComboRow(row, threads);
+                        rows.push_back(row);
+                    }
+                    ++combo;
                 }
             }
         }
     }
 
+    if (sharded) {
+        if (outPath.empty())
+            outPath = "tuner_shard_" + to_string(shardIndex) + "_of_" + to_string(shardCount) + ".bin";
+        ShardHeader h{};
+        memcpy(h.magic, SHARD_MAGIC, 4);
+        h.version = SHARD_VERSION;
+        h.seed = seed;
+        h.totalGames = totalGames;
+        h.blockGames = blockGames;
+        h.shardIndex = shardIndex;
+        h.shardCount = shardCount;
+        h.comboCount = combo;
+        h.recordCount = static_cast<int32_t>(records.size());
+        h.threads = threads;
+        if (!writeShardFile(outPath, h, records, recordHists)) { cerr << "cannot write " << outPath << endl; return 1; }
+        cerr << "[shard " << shardIndex << "/" << shardCount << " wrote " << records.size()
+             << " combos to " << outPath << "]" << endl;
+    } else if (!summaryPath.empty() && !writeSummaryJson(summaryPath, seed, totalGames, rows)) {
+        cerr << "cannot write " << summaryPath << endl;
+        return 1;
+    }
+    setEngineMetrics(nullptr);
+
+    if (profile != PROFILE_OFF) {
+        setProfileMode(PROFILE_OFF);
+        cerr << profileSummary();
+        if (!tracePath.empty()) {
+            FILE *f = fopen(tracePath.c_str(), "w");
+            string json = profileTraceJson();
+            if (!f || fwrite(json.data(), 1, json.size(), f) != json.size()) {
+                cerr << "cannot write " << tracePath << endl;
+                if (f) fclose(f);
+                return 1;
+            }
+            fclose(f);
+            cerr << "[trace written to " << tracePath << "]" << endl;
+        }
+    }
+
     return 0;
 }
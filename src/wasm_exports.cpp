@@ -1,70 +1,177 @@
 #include "wasm_exports.h"
 #include "Tournament.h"
 #include "MLforAI.h"
+#include "Replay.h"
+#include "Metrics.h"
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+#ifdef BATTLESHIP_THREADS
+#include "WorkerPool.h"
+#endif
 
-static Tournament gTournament;
+// One tournament hosted by the module, addressed from JS by its handle.
+// Handle 1 is the default tournament behind the original single-game exports;
+// it plays with the global weights, every other handle owns a copy.
+struct TournamentSlot {
+    Tournament t;
+    AIWeights weights;
+    SharedGameState shared;
+};
+
+static const int DEFAULT_TOURNAMENT_HANDLE = 1;
+
+// Index = handle; slot 0 stays empty so 0 can mean "no tournament"
+static std::vector<std::unique_ptr<TournamentSlot>> gSlots;
+static std::mutex gSlotsMutex;
+
+static TournamentSlot *slotFor(int handle) {
+    std::lock_guard<std::mutex> lock(gSlotsMutex);
+    if (gSlots.size() <= DEFAULT_TOURNAMENT_HANDLE) {
+        gSlots.resize(DEFAULT_TOURNAMENT_HANDLE + 1);
+        gSlots[DEFAULT_TOURNAMENT_HANDLE].reset(new TournamentSlot());
+        gSlots[DEFAULT_TOURNAMENT_HANDLE]->t.shared = &gSlots[DEFAULT_TOURNAMENT_HANDLE]->shared;
+    }
+    if (handle <= 0 || handle >= static_cast<int>(gSlots.size())) return nullptr;
+    return gSlots[handle].get();
+}
+
+static Tournament &defaultTournament() {
+    return slotFor(DEFAULT_TOURNAMENT_HANDLE)->t;
+}
+
+static void weightsFromFloats(const float* arr, AIWeights &w) {
+    double vals[AI_WEIGHT_COUNT];
+    for (int i = 0; i < AI_WEIGHT_COUNT; ++i) vals[i] = arr[i];
+    weightsFromArray(vals, w);
+}
+
+static void weightsToFloats(const AIWeights &w, float* outArr) {
+    double vals[AI_WEIGHT_COUNT];
+    weightsToArray(w, vals);
+    for (int i = 0; i < AI_WEIGHT_COUNT; ++i) outArr[i] = static_cast<float>(vals[i]);
+}
 
 extern "C" {
 
+int createTournament(int mode, int totalRounds, unsigned seed) {
+    slotFor(DEFAULT_TOURNAMENT_HANDLE);
+    std::unique_ptr<TournamentSlot> slot(new TournamentSlot());
+    getAIWeights(slot->weights);
+    slot->t.weights = &slot->weights;
+    slot->t.shared = &slot->shared;
+    slot->t.start(mode, totalRounds, seed ? seed : static_cast<uint64_t>(std::time(nullptr)));
+
+    std::lock_guard<std::mutex> lock(gSlotsMutex);
+    for (size_t h = DEFAULT_TOURNAMENT_HANDLE + 1; h < gSlots.size(); ++h) {
+        if (!gSlots[h]) {
+            gSlots[h] = std::move(slot);
+            return static_cast<int>(h);
+        }
+    }
+    gSlots.push_back(std::move(slot));
+    return static_cast<int>(gSlots.size() - 1);
+}
+
+void destroyTournament(int handle) {
+    if (handle == DEFAULT_TOURNAMENT_HANDLE) return;
+    std::lock_guard<std::mutex> lock(gSlotsMutex);
+    if (handle > 0 && handle < static_cast<int>(gSlots.size())) gSlots[handle].reset();
+}
+
+const char* tickTournamentH(int handle) {
+    TournamentSlot *s = slotFor(handle);
+    return s ? s->t.tick() : "";
+}
+
+int tickTournamentBatchH(int handle, int n, void* eventBuf) {
+    TournamentSlot *s = slotFor(handle);
+    if (!s || !eventBuf || n <= 0) return 0;
+    return s->t.tickBatch(n, static_cast<TickEvent*>(eventBuf));
+}
+
+int isTournamentDoneH(int handle) {
+    TournamentSlot *s = slotFor(handle);
+    return s ? s->t.done() : 1;
+}
+
+const void* getSharedStatePtrH(int handle) {
+    TournamentSlot *s = slotFor(handle);
+    return s ? &s->shared : nullptr;
+}
+
+void setAIWeightsH(int handle, const float* arr) {
+    if (!arr) return;
+    if (handle == DEFAULT_TOURNAMENT_HANDLE) { setAIWeightsFromArray(arr); return; }
+    TournamentSlot *s = slotFor(handle);
+    if (s) weightsFromFloats(arr, s->weights);
+}
+
+void getAIWeightsH(int handle, float* outArr) {
+    if (!outArr) return;
+    if (handle == DEFAULT_TOURNAMENT_HANDLE) { getAIWeightsToArray(outArr); return; }
+    TournamentSlot *s = slotFor(handle);
+    if (s) weightsToFloats(s->weights, outArr);
+}
+
+// Original single-tournament exports: wrappers around the default handle
+
 void startTournament(int mode, int totalRounds) {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-    gTournament.start(mode, totalRounds);
+    defaultTournament().start(mode, totalRounds, static_cast<uint64_t>(std::time(nullptr)));
+}
+
+const void* getSharedStatePtr() {
+    return getSharedStatePtrH(DEFAULT_TOURNAMENT_HANDLE);
+}
+
+unsigned getSharedStateGeneration() {
+    return slotFor(DEFAULT_TOURNAMENT_HANDLE)->shared.generation;
 }
 
 const char* tickTournament() {
-    return gTournament.tick();
+    return tickTournamentH(DEFAULT_TOURNAMENT_HANDLE);
+}
+
+int tickTournamentBatch(int n, void* eventBuf) {
+    return tickTournamentBatchH(DEFAULT_TOURNAMENT_HANDLE, n, eventBuf);
 }
 
 int isTournamentDone() {
-    return gTournament.done();
+    return isTournamentDoneH(DEFAULT_TOURNAMENT_HANDLE);
 }
 
 const float* getBoardSnapshot() {
-    return gTournament.snapshotBoard();
+    return defaultTournament().snapshotBoard();
 }
 
 const float* getHeatmapSnapshot() {
-    return gTournament.getHeatmapSnapshot();
+    return defaultTournament().getHeatmapSnapshot();
 }
 
 const float* getPlayer1BoardSnapshot() {
-    return gTournament.snapshotPlayer1Board();
+    return defaultTournament().snapshotPlayer1Board();
 }
 
 const float* getPlayer2BoardSnapshot() {
-    return gTournament.snapshotPlayer2Board();
+    return defaultTournament().snapshotPlayer2Board();
 }
 
 const float* getPlayer1HeatmapSnapshot() {
-    return gTournament.getPlayer1Heatmap();
+    return defaultTournament().getPlayer1Heatmap();
 }
 
 const float* getPlayer2HeatmapSnapshot() {
-    return gTournament.getPlayer2Heatmap();
+    return defaultTournament().getPlayer2Heatmap();
 }
 }
 // Set AI weights from a float array. Caller must pass an array of at least 16 floats.
 extern "C" void setAIWeightsFromArray(const float* arr) {
     if (!arr) return;
     AIWeights w;
-    w.globalAlphaEarly = arr[0];
-    w.globalAlphaLate  = arr[1];
-    w.liveDecayFactor  = arr[2];
-    w.tacticalLiveBonus = arr[3];
-    w.parityBonus       = arr[4];
-    w.parityPenalty     = arr[5];
-    w.adjHitBonus       = arr[6];
-    w.adjLineBonus      = arr[7];
-    w.diagHitBonus      = arr[8];
-    w.fitScoreNearAdjFactor = arr[9];
-    w.fitScoreBaseFactor    = arr[10];
-    w.noFitPenalty      = arr[11];
-    w.placementHitMultiplier = arr[12];
-    w.mcIterations      = static_cast<int>(arr[13]);
-    w.mcBlendRatio      = arr[14];
-    w.mcBlendThresholdCells = static_cast<int>(arr[15]);
+    weightsFromFloats(arr, w);
     setAIWeights(w);
 }
 
@@ -73,33 +180,129 @@ extern "C" void getAIWeightsToArray(float* outArr) {
     if (!outArr) return;
     AIWeights w;
     getAIWeights(w);
-    outArr[0] = static_cast<float>(w.globalAlphaEarly);
-    outArr[1] = static_cast<float>(w.globalAlphaLate);
-    outArr[2] = static_cast<float>(w.liveDecayFactor);
-    outArr[3] = static_cast<float>(w.tacticalLiveBonus);
-    outArr[4] = static_cast<float>(w.parityBonus);
-    outArr[5] = static_cast<float>(w.parityPenalty);
-    outArr[6] = static_cast<float>(w.adjHitBonus);
-    outArr[7] = static_cast<float>(w.adjLineBonus);
-    outArr[8] = static_cast<float>(w.diagHitBonus);
-    outArr[9] = static_cast<float>(w.fitScoreNearAdjFactor);
-    outArr[10] = static_cast<float>(w.fitScoreBaseFactor);
-    outArr[11] = static_cast<float>(w.noFitPenalty);
-    outArr[12] = static_cast<float>(w.placementHitMultiplier);
-    outArr[13] = static_cast<float>(w.mcIterations);
-    outArr[14] = static_cast<float>(w.mcBlendRatio);
-    outArr[15] = static_cast<float>(w.mcBlendThresholdCells);
+    weightsToFloats(w, outArr);
+}
+
+// Plays games [first, first + n) of a sweep as one Tournament, adding them to *out
+static void playBatchBlock(long long first, int n, uint64_t seed, const AIWeights *w, BatchResults *out) {
+    Tournament t;
+    t.weights = w;
+    t.start(3, n, seed, first);
+    TickEvent events[256];
+    while (!t.done()) {
+        int count = t.tickBatch(256, events);
+        for (int i = 0; i < count; ++i) {
+            const TickEvent &ev = events[i];
+            if (!(ev.flags & TICK_ROUND_END)) continue;
+            out->games++;
+            if (ev.winner == 1) out->winsP1++; else out->winsP2++;
+            out->avgShotsP1 += ev.shotsP1;   // sums until runGamesBatch divides
+            out->avgShotsP2 += ev.shotsP2;
+            if (ev.shotsP1 < BATCH_SHOT_BINS) out->shotHistP1[ev.shotsP1]++;
+            if (ev.shotsP2 < BATCH_SHOT_BINS) out->shotHistP2[ev.shotsP2]++;
+        }
+    }
+}
+
+extern "C" void runGamesBatch(int games, const float* weights, unsigned seed, BatchResults* results) {
+    if (!results) return;
+    std::memset(results, 0, sizeof(*results));
+    if (games <= 0) return;
+
+    AIWeights w;
+    if (weights) weightsFromFloats(weights, w);
+    else getAIWeights(w);
+
+    int blocks = (games + SWEEP_BLOCK_GAMES - 1) / SWEEP_BLOCK_GAMES;
+    std::vector<BatchResults> partial(blocks);
+    std::memset(partial.data(), 0, partial.size() * sizeof(BatchResults));
+    auto runBlock = [&](int b) {
+        long long first = static_cast<long long>(b) * SWEEP_BLOCK_GAMES;
+        int n = games - static_cast<int>(first) < SWEEP_BLOCK_GAMES ? games - static_cast<int>(first) : SWEEP_BLOCK_GAMES;
+        playBatchBlock(first, n, seed, &w, &partial[b]);
+    };
+#ifdef BATTLESHIP_THREADS
+    WorkerPool::shared().parallelFor(blocks, runBlock);
+#else
+    for (int b = 0; b < blocks; ++b) runBlock(b);
+#endif
+
+    // Integer sums, so the result does not depend on how blocks were scheduled
+    for (const BatchResults &p : partial) {
+        results->games += p.games;
+        results->winsP1 += p.winsP1;
+        results->winsP2 += p.winsP2;
+        results->avgShotsP1 += p.avgShotsP1;
+        results->avgShotsP2 += p.avgShotsP2;
+        for (int i = 0; i < BATCH_SHOT_BINS; ++i) {
+            results->shotHistP1[i] += p.shotHistP1[i];
+            results->shotHistP2[i] += p.shotHistP2[i];
+        }
+    }
+    if (results->games > 0) {
+        results->avgShotsP1 /= results->games;
+        results->avgShotsP2 /= results->games;
+    }
 }
 
 // Player move handling
 extern "C" int makePlayerMove(int row, int col) {
-    return gTournament.current.makePlayerMove(row, col);
+    return defaultTournament().current.makePlayerMove(row, col);
 }
 
 extern "C" int isPlayerTurn() {
-    return gTournament.current.isPlayerTurn();
+    return defaultTournament().current.isPlayerTurn();
 }
 
 extern "C" void advanceAITurn() {
-    gTournament.current.advanceAITurn();
+    defaultTournament().current.advanceAITurn();
+}
+
+extern "C" void setAIMoveBudget(double ms) {
+    Tournament &t = defaultTournament();
+    t.moveBudgetMs = ms;
+    t.current.moveBudgetMs = ms;
+}
+
+// Takes effect when the next tournament starts, with a fresh prior
+extern "C" void setLearnPrior(int on) {
+    defaultTournament().learnPrior = on != 0;
+}
+
+extern "C" int getLastMoveTier() {
+    return defaultTournament().current.lastTier;
+}
+
+extern "C" void setEngineProfileMode(int mode) {
+    setProfileMode(mode);
+}
+
+extern "C" void resetEngineProfile() {
+    resetProfile();
+}
+
+extern "C" int getEngineProfileCounters(double* out) {
+    if (!out) return PROFILE_PHASE_COUNT;
+    ProfileTotals tot = profileTotals();
+    for (int p = 0; p < PROFILE_PHASE_COUNT; ++p) {
+        out[2 * p] = static_cast<double>(tot.calls[p]);
+        out[2 * p + 1] = tot.ns[p] * 1e-6;
+    }
+    return PROFILE_PHASE_COUNT;
+}
+
+extern "C" const char* getEngineProfilePhaseName(int phase) {
+    return profilePhaseName(phase);
+}
+
+extern "C" const char* getEngineProfileSummary() {
+    static std::string text;
+    text = profileSummary();
+    return text.c_str();
+}
+
+extern "C" const char* getEngineProfileTrace() {
+    static std::string json;
+    json = profileTraceJson();
+    return json.c_str();
 }
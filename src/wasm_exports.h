@@ -1,12 +1,51 @@
 #pragma once
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Shots-to-finish histogram bins (index = shots fired in the game, 0..100)
+enum { BATCH_SHOT_BINS = 101 };
+
+// Filled by runGamesBatch; byte layout mirrored in tunerWorker.js
+// (games @0, winsP1 @4, winsP2 @8, avgShotsP1 @16, avgShotsP2 @24, shotHistP1 @32, shotHistP2 @436)
+struct BatchResults {
+    int32_t games;
+    int32_t winsP1;
+    int32_t winsP2;
+    int32_t reserved;
+    double avgShotsP1;
+    double avgShotsP2;
+    uint32_t shotHistP1[BATCH_SHOT_BINS];
+    uint32_t shotHistP2[BATCH_SHOT_BINS];
+};
+
+// Handle-based tournaments: each handle owns its game state, weights (copied from
+// the global weights at creation) and SharedGameState block, so a module can host
+// several tournaments at once. Handle 1 is the default tournament used by the
+// single-tournament exports below; 0 is never a valid handle.
+// seed 0 seeds from the clock.
+int createTournament(int mode, int totalRounds, unsigned seed);
+void destroyTournament(int handle);
+const char* tickTournamentH(int handle);
+int tickTournamentBatchH(int handle, int n, void* eventBuf);
+int isTournamentDoneH(int handle);
+const void* getSharedStatePtrH(int handle);
+void setAIWeightsH(int handle, const float* arr);
+void getAIWeightsH(int handle, float* outArr);
+
 // Start a new tournament
 void startTournament(int mode, int totalRounds);
 // Advance one move; returns short log string
 const char* tickTournament();
+// Advance up to n ticks, writing one 12-byte event per tick into eventBuf
+// (layout: TickEvent in Tournament.h); returns the number of events written
+int tickTournamentBatch(int n, void* eventBuf);
+// Render block (SharedGameState in Tournament.h) the engine updates as shots land;
+// read it through HEAP views and redraw only when the generation changes
+const void* getSharedStatePtr();
+unsigned getSharedStateGeneration();
 // Returns 1 when tournament finished
 int isTournamentDone();
 // 100 floats board snapshot (0 empty, 1 hit, -1 miss)
@@ -24,6 +63,12 @@ const float* getPlayer2HeatmapSnapshot();
 void setAIWeightsFromArray(const float* arr);
 void getAIWeightsToArray(float* outArr);
 
+// Play `games` AI-vs-AI games natively with the given 16 weights (null keeps the
+// current ones) and fill *results. Games are seeded and blocked exactly like the
+// native tuner's `seed=` sweeps, so the averages match `tuner seed=<seed>`.
+// The caller's weights are restored afterwards.
+void runGamesBatch(int games, const float* weights, unsigned seed, struct BatchResults* results);
+
 // Player move handling for interactive play
 // Returns: 0=invalid/not-your-turn, 1=valid-miss, 2=valid-hit, 3=valid-sunk-ship
 int makePlayerMove(int row, int col);
@@ -32,6 +77,23 @@ int isPlayerTurn();
 // Force AI to take its turn (for mode=2 after player moved)
 void advanceAITurn();
 
+// Per-move AI time budget in milliseconds (negative disables the budget)
+void setAIMoveBudget(double ms);
+// Refinement tier reached by the last AI move: 0 heuristic, 1 placement, 2 full
+int getLastMoveTier();
+
+// Hot-path phase profiler (ProfilePhase in Metrics.h).
+// mode: 0 off, 1 counters, 2 counters + trace events
+void setEngineProfileMode(int mode);
+void resetEngineProfile();
+// Writes calls and total milliseconds per phase as out[2*i], out[2*i+1];
+// returns the phase count
+int getEngineProfileCounters(double* out);
+const char* getEngineProfilePhaseName(int phase);
+// Text table / Chrome trace-event JSON; valid until the next call
+const char* getEngineProfileSummary();
+const char* getEngineProfileTrace();
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,6 +3,7 @@
 // const worker = new Worker('tunerWorker.js', { type: 'module' });
 // worker.postMessage({ cmd: 'start', params: { alphaRange: [0.65,0.85,0.05], placeRange: [1.0,2.0,0.5], ... } });
 // worker will postMessage({ type: 'progress', pct, row, total }) and finally postMessage({ type: 'done', results })
+// With params.seed set, results match `./tuner seed=<seed>` for the same weights (runGamesBatch builds).
 
 self.onmessage = async (ev) => {
   const msg = ev.data;
@@ -12,9 +13,9 @@ self.onmessage = async (ev) => {
     postMessage({ type: 'log', message: 'tunerWorker starting...' });
     try {
       // Load WASM module (ES6 module build)
-      importScripts(); // no-op placeholder for compatibility
-      const createModule = (await import('./dist/battleship.js')).default;
-      const mod = await createModule({});
+      const { loadBattleshipModule } = await import('./wasmLoader.js');
+      const { mod, flavor } = await loadBattleshipModule({});
+      postMessage({ type: 'log', message: `tunerWorker using ${flavor} build` });
 
       // Wrap C functions
       const startTournament = mod.cwrap('startTournament', null, ['number','number']);
@@ -61,9 +62,39 @@ self.onmessage = async (ev) => {
         return out;
       }
 
+      // Native batch runner: whole tournaments per call, results in a BatchResults
+      // struct (wasm_exports.h): games @0, winsP1 @4, winsP2 @8, avgShotsP1 @16,
+      // avgShotsP2 @24, shotHistP1 @32, shotHistP2 @436 (101 uint32 bins each)
+      const BATCH_RESULTS_BYTES = 840, BATCH_SHOT_BINS = 101;
+      let runGamesBatch = null;
+      try { runGamesBatch = mod.cwrap('runGamesBatch', null, ['number','number','number','number']); }
+      catch (e) { runGamesBatch = null; }
+
+      function runBatch(weightsObj, games, seed) {
+        const wptr = mod._malloc(16 * 4);
+        const rptr = mod._malloc(BATCH_RESULTS_BYTES);
+        try {
+          getAIWeightsWasm(wptr);
+          const view = new Float32Array(mod.HEAPF32.buffer, wptr, 16);
+          if (typeof weightsObj.globalAlphaEarly === 'number') view[0] = weightsObj.globalAlphaEarly;
+          if (typeof weightsObj.adjHitBonus === 'number') view[6] = weightsObj.adjHitBonus;
+          if (typeof weightsObj.placementHitMultiplier === 'number') view[12] = weightsObj.placementHitMultiplier;
+          if (typeof weightsObj.mcBlendRatio === 'number') view[14] = weightsObj.mcBlendRatio;
+          runGamesBatch(games, wptr, seed >>> 0, rptr);
+          const dv = new DataView(mod.HEAPU8.buffer, rptr, BATCH_RESULTS_BYTES);
+          const hist = (off) => Array.from({ length: BATCH_SHOT_BINS }, (_, i) => dv.getUint32(off + 4 * i, true));
+          return {
+            games: dv.getInt32(0, true), winsP1: dv.getInt32(4, true), winsP2: dv.getInt32(8, true),
+            p1avg: dv.getFloat64(16, true), p2avg: dv.getFloat64(24, true),
+            histP1: hist(32), histP2: hist(436),
+          };
+        } finally { mod._free(wptr); mod._free(rptr); }
+      }
+
       // read params
       const params = msg.params || {};
       const games = params.games || 200;
+      const seed = params.seed || 1;
       const alphaRange = parseRange(params.alpha || '', 0.75, 0.05, 0.85);
       const placeRange = parseRange(params.place || '', 1.0, 0.5, 2.0);
       const adjRange = parseRange(params.adj || '', 0.2, 0.2, 0.6);
@@ -79,6 +110,13 @@ self.onmessage = async (ev) => {
           for (const adj of adjRange) {
             for (const mc of mcRange) {
               comboIndex++;
+              if (runGamesBatch) {
+                const r = runBatch({ globalAlphaEarly: alpha, placementHitMultiplier: place, adjHitBonus: adj, mcBlendRatio: mc }, games, seed);
+                const row = { alpha, place, adj, mc, p1avg: r.p1avg, p2avg: r.p2avg, winsP1: r.winsP1, winsP2: r.winsP2, histP1: r.histP1 };
+                results.push(row);
+                postMessage({ type: 'progress', comboIndex, totalCombos, last: { alpha, place, adj, mc, p1avg: r.p1avg, p2avg: r.p2avg } });
+                continue;
+              }
               // set weights
               setWeights({ globalAlphaEarly: alpha, placementHitMultiplier: place, adjHitBonus: adj, mcBlendRatio: mc });
 
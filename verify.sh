@@ -30,6 +30,10 @@ REQUIRED_FILES=(
   "src/MLforAI.h"
   "src/Tournament.cpp"
   "src/Tournament.h"
+  "src/simd_kernels.cpp"
+  "src/simd_kernels.h"
+  "src/Metrics.cpp"
+  "src/Metrics.h"
   "src/wasm_exports.cpp"
   "src/wasm_exports.h"
 )
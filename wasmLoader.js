@@ -0,0 +1,34 @@
+// wasmLoader.js - picks the fastest WASM build this browser can run
+//
+// dist/battleship-simd.js needs WebAssembly SIMD128 plus threads (SharedArrayBuffer,
+// which browsers only expose on cross-origin isolated pages: COOP/COEP headers,
+// see scripts/serve_isolated.py). Anything else gets the baseline dist/battleship.js.
+
+// Smallest module using a SIMD instruction (i8x16.splat + i8x16.popcnt)
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+  10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+export function detectWasmFeatures() {
+  let simd = false;
+  try { simd = WebAssembly.validate(SIMD_PROBE); } catch (e) { simd = false; }
+  const threads = typeof SharedArrayBuffer !== 'undefined' &&
+                  (typeof crossOriginIsolated === 'undefined' || crossOriginIsolated === true);
+  return { simd, threads };
+}
+
+// Resolves to { mod, flavor } where flavor is 'simd' or 'baseline'
+export async function loadBattleshipModule(options = {}) {
+  const { simd, threads } = detectWasmFeatures();
+  if (simd && threads) {
+    try {
+      const createModule = (await import('./dist/battleship-simd.js')).default;
+      return { mod: await createModule(options), flavor: 'simd' };
+    } catch (e) {
+      console.warn('SIMD/threads build unavailable, using baseline:', e);
+    }
+  }
+  const createModule = (await import('./dist/battleship.js')).default;
+  return { mod: await createModule(options), flavor: 'baseline' };
+}